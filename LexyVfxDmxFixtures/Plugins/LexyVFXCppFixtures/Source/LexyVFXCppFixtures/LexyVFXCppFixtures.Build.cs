@@ -40,11 +40,22 @@ public class LexyVFXCppFixtures : ModuleRules
 				"Engine",
 				"Slate",
 				"SlateCore",
+				"LevelSequence",
+				"MovieScene",
+				"MovieSceneTracks",
+				"Sockets",
+				"Networking",
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
 		
 		
+		// Undo of building and clearing a rig in the editor
+		if (Target.bBuildEditor)
+		{
+			PrivateDependencyModuleNames.Add("UnrealEd");
+		}
+		
 		DynamicallyLoadedModuleNames.AddRange(
 			new string[]
 			{
@@ -2,6 +2,16 @@
 
 
 #include "LexyVFXDMXBaseComponent.h"
+#include "LexyVFXDMXFixtureType.h"
+#include "LexyVFXDMXFunctionManager.h"
+#include "LexyVFXDMXFixtureSubsystem.h"
+#include "LexyVFXDMXDecoders.h"
+
+namespace LexyVFXDMXBaseComponent
+{
+	// Decoders read up to four DMX functions, the ones a fixture type doesn't name read as 0
+	static const int32 MinFunctionValues = 4;
+}
 
 // Sets default values for this component's properties
 ULexyVFXDMXBaseComponent::ULexyVFXDMXBaseComponent()
@@ -19,8 +29,63 @@ void ULexyVFXDMXBaseComponent::BeginPlay()
 {
 	Super::BeginPlay();
 
-	// ...
-	
+	ULexyVFXDMXFixtureSubsystem *FixtureSubsystem = ULexyVFXDMXFixtureSubsystem::Get(this);
+	if (!FixtureSubsystem || !FixtureSubsystem->DeferInitialization(this->GetOwner()))
+		this->InitializeFunction();
+}
+
+void ULexyVFXDMXBaseComponent::InitializeFunction()
+{
+	bFunctionInitialized = true;
+
+	ULexyVFXDMXFunctionManager *FunctionManager = this->GetOwner()->FindComponentByClass<ULexyVFXDMXFunctionManager>();
+	if (!FixtureType)
+		FixtureType = FunctionManager && FunctionManager->FixtureType ? FunctionManager->FixtureType : GetMutableDefault<ULexyVFXDMXFixtureType>();
+	this->BindDecoder();
+	this->BindComponents();
+
+	// Components added after the manager initialized join it here, the manager hands down its DMX component and patch
+	if (FunctionManager && FunctionManager->bFixtureInitialized)
+		FunctionManager->AddFunctionComponent(this);
+}
+
+void ULexyVFXDMXBaseComponent::PostLoad()
+{
+	Super::PostLoad();
+
+#if WITH_EDITORONLY_DATA
+	// Blueprints saved before fixture types existed keep their bit depths and ranges in a type of their own, created
+	// next to the component so it's saved with the Blueprint on its next save
+	if (!FixtureType && !HasAnyFlags(RF_ClassDefaultObject))
+	{
+		ULexyVFXDMXFixtureType *MigratedType = NewObject<ULexyVFXDMXFixtureType>(this, NAME_None, RF_Transactional);
+		if (this->MigrateDeprecatedConfig(*MigratedType))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Moved the DMX bit depths and ranges of %s into a fixture type"), *GetPathName());
+			FixtureType = MigratedType;
+		}
+		else
+		{
+			MigratedType->MarkPendingKill();
+		}
+	}
+#endif
+}
+
+#if WITH_EDITORONLY_DATA
+bool ULexyVFXDMXBaseComponent::MigrateDeprecatedConfig(ULexyVFXDMXFixtureType& Type) const
+{
+	return false;
+}
+#endif
+
+void ULexyVFXDMXBaseComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (ULexyVFXDMXFunctionManager *FunctionManager = this->GetOwner()->FindComponentByClass<ULexyVFXDMXFunctionManager>())
+		FunctionManager->RemoveFunctionComponent(this);
+	bFunctionInitialized = false;
+
+	Super::EndPlay(EndPlayReason);
 }
 
 
@@ -55,14 +120,14 @@ void ULexyVFXDMXBaseComponent::SetParentDMXRef()
 	}
 }
 
-void ULexyVFXDMXBaseComponent::InitDMXFunctionNames(TArray<FName> DMXFunctionNames)
+const ULexyVFXDMXFixtureType* ULexyVFXDMXBaseComponent::GetFixtureType() const
 {
-	this->FunctionNames.nDMXComponentFunctions = DMXFunctionNames;
+	if (FixtureType)
+		return FixtureType;
 
-	for (auto& name : DMXFunctionNames)
-	{
-		UE_LOG(LogTemp, Warning, TEXT("%s"), *name.ToString());
-	}
+	// Only reached before BeginPlay, e.g. when baking from an editor world
+	const ULexyVFXDMXFunctionManager *FunctionManager = this->GetOwner() ? this->GetOwner()->FindComponentByClass<ULexyVFXDMXFunctionManager>() : nullptr;
+	return FunctionManager ? FunctionManager->GetFixtureType() : ULexyVFXDMXFixtureType::GetDefaultType();
 }
 
 TArray<UActorComponent*> ULexyVFXDMXBaseComponent::FindComponentsByName(TSubclassOf<UActorComponent> ComponentType, TArray<FString> searchNames)
@@ -70,6 +135,27 @@ TArray<UActorComponent*> ULexyVFXDMXBaseComponent::FindComponentsByName(TSubclas
 	TArray<UActorComponent*> actorComponents;
 	this->GetOwner()->GetComponents(ComponentType, actorComponents);
 
+	// Every fixture of an actor class names its components the same, so only the first one of each class searches
+	ULexyVFXDMXFixtureSubsystem *FixtureSubsystem = ULexyVFXDMXFixtureSubsystem::Get(this);
+	if (FixtureSubsystem)
+	{
+		if (const TArray<FName>* ComponentNames = FixtureSubsystem->FindComponentBinding(this->GetOwner()->GetClass(), ComponentType, searchNames))
+		{
+			TArray<UActorComponent*> outComps;
+			for (const FName& ComponentName : *ComponentNames)
+			{
+				UActorComponent* const* Found = actorComponents.FindByPredicate([&ComponentName](const UActorComponent *Component) { return Component->GetFName() == ComponentName; });
+				if (!Found)
+					break;
+				outComps.Add(*Found);
+			}
+
+			// Falls back to searching when this instance's components differ from its class
+			if (outComps.Num() == ComponentNames->Num())
+				return outComps;
+		}
+	}
+
 	//TInlineComponentArray<UActorComponent*> actorComponents;
 	//this->GetOwner()->GetComponents(actorComponents, false);
 
@@ -110,65 +196,123 @@ TArray<UActorComponent*> ULexyVFXDMXBaseComponent::FindComponentsByName(TSubclas
 		}
 
 	}
+
+	if (FixtureSubsystem)
+		FixtureSubsystem->AddComponentBinding(this->GetOwner()->GetClass(), ComponentType, searchNames, outComps);
 	return outComps;
 }
 
-void ULexyVFXDMXBaseComponent::UpdateDMX(TMap<FDMXAttributeName, int32> DImapDMXFunctionValues, TArray<FName> nDMXComponentFunctions)
+void ULexyVFXDMXBaseComponent::BindComponents()
 {
 }
 
-void ULexyVFXDMXBaseComponent::UpdateDMXMaterialScalarParameter(UMaterialInstanceDynamic * miTargetMaterial, EDMXParameterBitDepth DMXBitDepth, FName nMaterialParameterName, float fScaleFactor, float fRangeMin, float fRangeMax, TMap<FDMXAttributeName, int32> DImapDMXFunctionValues, FName nDMXComponentFunction)
+UMaterialInstanceDynamic* ULexyVFXDMXBaseComponent::BindDynamicMaterial(UStaticMeshComponent *Mesh)
 {
-	float fMaxParameterRange;
-	float fScalar;
+	return Mesh ? Mesh->CreateDynamicMaterialInstance(DynamicMaterialIndex, Mesh->GetMaterial(DynamicMaterialIndex)) : nullptr;
+}
 
-	switch (DMXBitDepth)
+void ULexyVFXDMXBaseComponent::DecodeDMX(const TMap<FDMXAttributeName, int32>& DImapDMXFunctionValues, FLexyVFXDMXFixtureOutput& Output) const
+{
+	using namespace LexyVFXDMXBaseComponent;
+
+	const ULexyVFXDMXFixtureType *Type = this->GetFixtureType();
+
+	// Not bound yet before BeginPlay, e.g. when baking from an editor world
+	const FLexyVFXDMXDecodeFunction Decode = DecodeFunction ? DecodeFunction : this->SelectDecoder(*Type);
+	if (!Decode)
+		return;
+
+	const TArray<FName>& nFunctionNames = this->GetFunctionNames(*Type);
+	const int32 numValues = FMath::Max(nFunctionNames.Num(), MinFunctionValues);
+	TArray<int32, TInlineAllocator<MinFunctionValues>> FunctionValues;
+	TArray<int32, TInlineAllocator<MinFunctionValues>> FunctionIndices;
+	FunctionValues.SetNumZeroed(numValues);
+	FunctionIndices.SetNumUninitialized(numValues);
+	for (int32 i = 0; i != numValues; i++)
 	{
-	case EDMXParameterBitDepth::BitDepth_8bits:
-		fMaxParameterRange = 255.0f;
-		break;
-	case EDMXParameterBitDepth::BitDepth_16bits:
-		fMaxParameterRange = 65535.0f;
-		break;
-	case EDMXParameterBitDepth::BitDepth_24bits:
-		fMaxParameterRange = 16777215.0f;
-		break;
-	default:
-		fMaxParameterRange = 255.0f;
-		break;
+		FunctionIndices[i] = i;
+		if (i < nFunctionNames.Num())
+			FunctionValues[i] = DImapDMXFunctionValues.FindRef(nFunctionNames[i]);
 	}
 
-	fScalar = fScaleFactor * FMath::GetMappedRangeValueClamped(FVector2D(0.0f, fMaxParameterRange), FVector2D(fRangeMin, fRangeMax), (float)DImapDMXFunctionValues.FindRef(nDMXComponentFunction));
+	Decode(*Type, FunctionValues.GetData(), FunctionIndices.GetData(), Output);
+}
+
+void ULexyVFXDMXBaseComponent::DecodeChannels(const int32 *ChannelValues, FLexyVFXDMXFixtureOutput& Output) const
+{
+	if (DecodeFunction && ChannelIndices.Num() > 0)
+		DecodeFunction(*this->GetFixtureType(), ChannelValues, ChannelIndices.GetData(), Output);
+}
+
+const TArray<FName>& ULexyVFXDMXBaseComponent::GetFunctionNames(const ULexyVFXDMXFixtureType& Type) const
+{
+	static const TArray<FName> nNoFunctions;
+	return nNoFunctions;
+}
+
+void ULexyVFXDMXBaseComponent::BindChannels(const TArray<FLexyVFXDMXChannelOffset>& ChannelOffsets)
+{
+	using namespace LexyVFXDMXBaseComponent;
+
+	const TArray<FName>& nFunctionNames = this->GetFunctionNames(*this->GetFixtureType());
+	ChannelIndices.Init(ChannelOffsets.Num(), FMath::Max(nFunctionNames.Num(), MinFunctionValues));
+	for (int32 i = 0; i != nFunctionNames.Num(); i++)
+	{
+		// The last of a repeated attribute wins, as it did when the values were gathered into a map
+		const FName& nFunctionName = nFunctionNames[i];
+		const int32 offsetIndex = ChannelOffsets.FindLastByPredicate([&nFunctionName](const FLexyVFXDMXChannelOffset& ChannelOffset) { return ChannelOffset.Attribute.Name == nFunctionName; });
+		if (offsetIndex != INDEX_NONE)
+			ChannelIndices[i] = offsetIndex;
+	}
+}
+
+FLexyVFXDMXDecodeFunction ULexyVFXDMXBaseComponent::SelectDecoder(const ULexyVFXDMXFixtureType& Type) const
+{
+	return nullptr;
+}
+
+void ULexyVFXDMXBaseComponent::BindDecoder()
+{
+	DecodeFunction = this->SelectDecoder(*this->GetFixtureType());
+
+	// The fixture type's function names may have changed with it
+	const ULexyVFXDMXFunctionManager *FunctionManager = this->GetOwner()->FindComponentByClass<ULexyVFXDMXFunctionManager>();
+	this->BindChannels(FunctionManager ? FunctionManager->ChannelOffsets : TArray<FLexyVFXDMXChannelOffset>());
+}
+
+void ULexyVFXDMXBaseComponent::ApplyOutput(const FLexyVFXDMXFixtureOutput& Output)
+{
+}
+
+void ULexyVFXDMXBaseComponent::DescribeBakedTracks(ILexyVFXDMXBakedTracks& Tracks) const
+{
+}
+
+void ULexyVFXDMXBaseComponent::UpdateDMX(TMap<FDMXAttributeName, int32> DImapDMXFunctionValues, TArray<FName> nDMXComponentFunctions)
+{
+	FLexyVFXDMXFixtureOutput Output;
+	this->DecodeDMX(DImapDMXFunctionValues, Output);
+	this->ApplyOutput(Output);
+}
+
+void ULexyVFXDMXBaseComponent::UpdateDMXMaterialScalarParameter(UMaterialInstanceDynamic * miTargetMaterial, EDMXParameterBitDepth DMXBitDepth, FName nMaterialParameterName, float fScaleFactor, float fRangeMin, float fRangeMax, TMap<FDMXAttributeName, int32> DImapDMXFunctionValues, FName nDMXComponentFunction)
+{
+	float fScalar;
+
+	fScalar = fScaleFactor * LexyVFXDMXDecoders::MapRange(DMXBitDepth, DImapDMXFunctionValues.FindRef(nDMXComponentFunction), fRangeMin, fRangeMax);
 
 	miTargetMaterial->SetScalarParameterValue(nMaterialParameterName, fScalar);
 }
 
 void ULexyVFXDMXBaseComponent::UpdateDMXMaterialVectorParameter(UMaterialInstanceDynamic * miTargetMaterial, EDMXParameterBitDepth DMXBitDepth, FName nMaterialParameterName, TMap<FDMXAttributeName, int32> DImapDMXFunctionValues, TArray<FName> nDMXComponentFunctions)
 {
-	float fMaxParameterRange;
 	FVector4 inVector4;
 	FVector4 outVector4;
 
-	switch (DMXBitDepth)
-	{
-	case EDMXParameterBitDepth::BitDepth_8bits:
-		fMaxParameterRange = 255.0f;
-		break;
-	case EDMXParameterBitDepth::BitDepth_16bits:
-		fMaxParameterRange = 65535.0f;
-		break;
-	case EDMXParameterBitDepth::BitDepth_24bits:
-		fMaxParameterRange = 16777215.0f;
-		break;
-	default:
-		fMaxParameterRange = 255.0f;
-		break;
-	}
-
-	inVector4.W = FMath::GetMappedRangeValueClamped(FVector2D(0.0f, fMaxParameterRange), FVector2D(0.0f, 1.0f), (float)DImapDMXFunctionValues.FindRef(nDMXComponentFunctions[0]));
-	inVector4.X = FMath::GetMappedRangeValueClamped(FVector2D(0.0f, fMaxParameterRange), FVector2D(0.0f, 1.0f), (float)DImapDMXFunctionValues.FindRef(nDMXComponentFunctions[1]));
-	inVector4.Y = FMath::GetMappedRangeValueClamped(FVector2D(0.0f, fMaxParameterRange), FVector2D(0.0f, 1.0f), (float)DImapDMXFunctionValues.FindRef(nDMXComponentFunctions[2]));
-	inVector4.Z = FMath::GetMappedRangeValueClamped(FVector2D(0.0f, fMaxParameterRange), FVector2D(0.0f, 1.0f), (float)DImapDMXFunctionValues.FindRef(nDMXComponentFunctions[3]));
+	inVector4.W = LexyVFXDMXDecoders::MapRange(DMXBitDepth, DImapDMXFunctionValues.FindRef(nDMXComponentFunctions[0]), 0.0f, 1.0f);
+	inVector4.X = LexyVFXDMXDecoders::MapRange(DMXBitDepth, DImapDMXFunctionValues.FindRef(nDMXComponentFunctions[1]), 0.0f, 1.0f);
+	inVector4.Y = LexyVFXDMXDecoders::MapRange(DMXBitDepth, DImapDMXFunctionValues.FindRef(nDMXComponentFunctions[2]), 0.0f, 1.0f);
+	inVector4.Z = LexyVFXDMXDecoders::MapRange(DMXBitDepth, DImapDMXFunctionValues.FindRef(nDMXComponentFunctions[3]), 0.0f, 1.0f);
 
 	outVector4.W = 1.0f;
 	outVector4.X = FMath::Min(inVector4.W + inVector4.Z, 1.0f);
@@ -180,30 +324,13 @@ void ULexyVFXDMXBaseComponent::UpdateDMXMaterialVectorParameter(UMaterialInstanc
 
 void ULexyVFXDMXBaseComponent::UpdateDMXLightColor(EDMXParameterBitDepth DMXBitDepth, ULightComponent * LightComponentRef, float fRange, TMap<FDMXAttributeName, int32> DImapDMXFunctionValues, TArray<FName> nDMXComponentFunctions)
 {
-	float fMaxParameterRange;
 	FVector4 inVector4;
 	FVector4 outVector4;
 
-	switch (DMXBitDepth)
-	{
-	case EDMXParameterBitDepth::BitDepth_8bits:
-		fMaxParameterRange = 255.0f;
-		break;
-	case EDMXParameterBitDepth::BitDepth_16bits:
-		fMaxParameterRange = 65535.0f;
-		break;
-	case EDMXParameterBitDepth::BitDepth_24bits:
-		fMaxParameterRange = 16777215.0f;
-		break;
-	default:
-		fMaxParameterRange = 255.0f;
-		break;
-	}
-
-	inVector4.W = FMath::GetMappedRangeValueClamped(FVector2D(0.0f, fMaxParameterRange), FVector2D(0.0f, 1.0f), (float)DImapDMXFunctionValues.FindRef(nDMXComponentFunctions[0]));
-	inVector4.X = FMath::GetMappedRangeValueClamped(FVector2D(0.0f, fMaxParameterRange), FVector2D(0.0f, 1.0f), (float)DImapDMXFunctionValues.FindRef(nDMXComponentFunctions[1]));
-	inVector4.Y = FMath::GetMappedRangeValueClamped(FVector2D(0.0f, fMaxParameterRange), FVector2D(0.0f, 1.0f), (float)DImapDMXFunctionValues.FindRef(nDMXComponentFunctions[2]));
-	inVector4.Z = FMath::GetMappedRangeValueClamped(FVector2D(0.0f, fMaxParameterRange), FVector2D(0.0f, 1.0f), (float)DImapDMXFunctionValues.FindRef(nDMXComponentFunctions[3]));
+	inVector4.W = LexyVFXDMXDecoders::MapRange(DMXBitDepth, DImapDMXFunctionValues.FindRef(nDMXComponentFunctions[0]), 0.0f, 1.0f);
+	inVector4.X = LexyVFXDMXDecoders::MapRange(DMXBitDepth, DImapDMXFunctionValues.FindRef(nDMXComponentFunctions[1]), 0.0f, 1.0f);
+	inVector4.Y = LexyVFXDMXDecoders::MapRange(DMXBitDepth, DImapDMXFunctionValues.FindRef(nDMXComponentFunctions[2]), 0.0f, 1.0f);
+	inVector4.Z = LexyVFXDMXDecoders::MapRange(DMXBitDepth, DImapDMXFunctionValues.FindRef(nDMXComponentFunctions[3]), 0.0f, 1.0f);
 
 	outVector4.W = 1.0f;
 	outVector4.X = FMath::Min(inVector4.W + inVector4.Z, 1.0f);
@@ -215,50 +342,15 @@ void ULexyVFXDMXBaseComponent::UpdateDMXLightColor(EDMXParameterBitDepth DMXBitD
 
 void ULexyVFXDMXBaseComponent::UpdateDMXSpringArm(EDMXParameterBitDepth DMXBitDepth, USpringArmComponent * SpringArmComponentRef, float fRange, TMap<FDMXAttributeName, int32> DImapDMXFunctionValues, FName nDMXComponentFunction)
 {
-	float fMaxParameterRange;
-
-	switch (DMXBitDepth)
-	{
-	case EDMXParameterBitDepth::BitDepth_8bits:
-		fMaxParameterRange = 255.0f;
-		break;
-	case EDMXParameterBitDepth::BitDepth_16bits:
-		fMaxParameterRange = 65535.0f;
-		break;
-	case EDMXParameterBitDepth::BitDepth_24bits:
-		fMaxParameterRange = 16777215.0f;
-		break;
-	default:
-		fMaxParameterRange = 255.0f;
-		break;
-	}
-
-	SpringArmComponentRef->TargetArmLength = FMath::GetMappedRangeValueClamped(FVector2D(0.0f, fMaxParameterRange), FVector2D(0.0f, fRange), (float)DImapDMXFunctionValues.FindRef(nDMXComponentFunction));
+	SpringArmComponentRef->TargetArmLength = LexyVFXDMXDecoders::MapRange(DMXBitDepth, DImapDMXFunctionValues.FindRef(nDMXComponentFunction), 0.0f, fRange);
 }
 
 bool ULexyVFXDMXBaseComponent::UpdateDMXSpotConeAngle(EDMXParameterBitDepth DMXBitDepth, ULightComponent * LightComponentRef, float fBeamRangeMax, float fBeamRangeMin, TMap<FDMXAttributeName, int32> DImapDMXFunctionValues, FName nDMXComponentFunction)
 {
 	USpotLightComponent *SpotComponent = Cast<USpotLightComponent>(LightComponentRef);
-	float fMaxParameterRange;
 	float outFloat;
 
-	switch (DMXBitDepth)
-	{
-	case EDMXParameterBitDepth::BitDepth_8bits:
-		fMaxParameterRange = 255.0f;
-		break;
-	case EDMXParameterBitDepth::BitDepth_16bits:
-		fMaxParameterRange = 65535.0f;
-		break;
-	case EDMXParameterBitDepth::BitDepth_24bits:
-		fMaxParameterRange = 16777215.0f;
-		break;
-	default:
-		fMaxParameterRange = 255.0f;
-		break;
-	}
-
-	outFloat = 0.7f * FMath::GetMappedRangeValueClamped(FVector2D(0.0f, fMaxParameterRange), FVector2D(fBeamRangeMax, fBeamRangeMin), (float)DImapDMXFunctionValues.FindRef(nDMXComponentFunction));
+	outFloat = 0.7f * LexyVFXDMXDecoders::MapRange(DMXBitDepth, DImapDMXFunctionValues.FindRef(nDMXComponentFunction), fBeamRangeMax, fBeamRangeMin);
 
 	if (SpotComponent)
 	{
@@ -274,50 +366,14 @@ bool ULexyVFXDMXBaseComponent::UpdateDMXSpotConeAngle(EDMXParameterBitDepth DMXB
 
 void ULexyVFXDMXBaseComponent::UpdateDMXLightIntensity(EDMXParameterBitDepth DMXBitDepth, ULightComponent * LightComponentRef, float fRange, TMap<FDMXAttributeName, int32> DImapDMXFunctionValues, FName nDMXComponentFunction)
 {
-	float fMaxParameterRange;
-
-	switch (DMXBitDepth)
-	{
-	case EDMXParameterBitDepth::BitDepth_8bits:
-		fMaxParameterRange = 255.0f;
-		break;
-	case EDMXParameterBitDepth::BitDepth_16bits:
-		fMaxParameterRange = 65535.0f;
-		break;
-	case EDMXParameterBitDepth::BitDepth_24bits:
-		fMaxParameterRange = 16777215.0f;
-		break;
-	default:
-		fMaxParameterRange = 255.0f;
-		break;
-	}
-
-	LightComponentRef->Intensity = FMath::GetMappedRangeValueClamped(FVector2D(0.0f, fMaxParameterRange), FVector2D(0.0f, fRange), (float)DImapDMXFunctionValues.FindRef(nDMXComponentFunction));
+	LightComponentRef->Intensity = LexyVFXDMXDecoders::MapRange(DMXBitDepth, DImapDMXFunctionValues.FindRef(nDMXComponentFunction), 0.0f, fRange);
 }
 
 bool ULexyVFXDMXBaseComponent::UpdateDMXRotation(EDMXParameterBitDepth DMXBitDepth, USceneComponent * SceneComponentRef, EDMXRotationMode eRotationMode, float fRange, TMap<FDMXAttributeName, int32> DImapDMXFunctionValues, FName nDMXComponentFunction)
 {
-	float fMaxParameterRange;
 	float outFloat;
 
-	switch (DMXBitDepth)
-	{
-	case EDMXParameterBitDepth::BitDepth_8bits:
-		fMaxParameterRange = 255.0f;
-		break;
-	case EDMXParameterBitDepth::BitDepth_16bits:
-		fMaxParameterRange = 65535.0f;
-		break;
-	case EDMXParameterBitDepth::BitDepth_24bits:
-		fMaxParameterRange = 16777215.0f;
-		break;
-	default:
-		fMaxParameterRange = 255.0f;
-		break;
-	}
-
-
-	outFloat = FMath::GetMappedRangeValueClamped(FVector2D(0.0f, fMaxParameterRange), FVector2D(fRange * -0.5f, fRange * 0.5f), (float)DImapDMXFunctionValues.FindRef(nDMXComponentFunction));
+	outFloat = LexyVFXDMXDecoders::MapRange(DMXBitDepth, DImapDMXFunctionValues.FindRef(nDMXComponentFunction), fRange * -0.5f, fRange * 0.5f);
 
 	switch (eRotationMode)
 	{
@@ -0,0 +1,339 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "LexyVFXDMXClusterReplicator.h"
+#include "LexyVFXDMXFixtureType.h"
+#include "Common/UdpSocketBuilder.h"
+#include "Interfaces/IPv4/IPv4Address.h"
+#include "Interfaces/IPv4/IPv4Endpoint.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+
+namespace LexyVFXDMXClusterReplicator
+{
+	static const int32 HeaderSize = 4 + 1 + 1 + 4 + 4 + 2;
+	static const int32 MaxRecordSize = 4 + 1 + 2 * FLexyVFXDMXQuantizedOutput::Field_Count;
+
+	// Datagrams and frames arrive this far out of order at most, anything further behind is a primary that restarted
+	// or a frame clock that jumped back
+	static const int32 MaxReorderDistance = 256;
+
+	static uint16 QuantizeUnit(float fValue)
+	{
+		return (uint16)FMath::RoundToInt(FMath::Clamp(fValue, 0.0f, 1.0f) * 65535.0f);
+	}
+
+	static float DequantizeUnit(uint16 Value)
+	{
+		return Value / 65535.0f;
+	}
+
+	// Over the fixture type's whole range centered on 0, e.g. 540 degrees of pan in steps of about 0.008 degrees
+	static uint16 QuantizeAngle(float fDegrees, float fRange)
+	{
+		const float fHalfRange = FMath::Max(fRange * 0.5f, KINDA_SMALL_NUMBER);
+		return QuantizeUnit((fDegrees + fHalfRange) / (2.0f * fHalfRange));
+	}
+
+	static float DequantizeAngle(uint16 Value, float fRange)
+	{
+		const float fHalfRange = FMath::Max(fRange * 0.5f, KINDA_SMALL_NUMBER);
+		return DequantizeUnit(Value) * 2.0f * fHalfRange - fHalfRange;
+	}
+}
+
+FLexyVFXDMXQuantizedOutput FLexyVFXDMXQuantizedOutput::Quantize(const FLexyVFXDMXFixtureOutput& Output, const ULexyVFXDMXFixtureType& Type)
+{
+	using namespace LexyVFXDMXClusterReplicator;
+
+	FLexyVFXDMXQuantizedOutput outQuantized;
+	outQuantized.Values[Field_Dimmer] = QuantizeUnit(Output.Dimmer);
+	outQuantized.Values[Field_Red] = QuantizeUnit(Output.Color.R);
+	outQuantized.Values[Field_Green] = QuantizeUnit(Output.Color.G);
+	outQuantized.Values[Field_Blue] = QuantizeUnit(Output.Color.B);
+	outQuantized.Values[Field_Zoom] = QuantizeUnit(Output.Zoom);
+	outQuantized.Values[Field_Pan] = QuantizeAngle(Output.Pan, Type.fPanRange);
+	outQuantized.Values[Field_Tilt] = QuantizeAngle(Output.Tilt, Type.fTiltRange);
+	return outQuantized;
+}
+
+FLexyVFXDMXFixtureOutput FLexyVFXDMXQuantizedOutput::Dequantize(const ULexyVFXDMXFixtureType& Type) const
+{
+	using namespace LexyVFXDMXClusterReplicator;
+
+	FLexyVFXDMXFixtureOutput outOutput;
+	outOutput.Dimmer = DequantizeUnit(Values[Field_Dimmer]);
+	outOutput.Color = FLinearColor(DequantizeUnit(Values[Field_Red]), DequantizeUnit(Values[Field_Green]), DequantizeUnit(Values[Field_Blue]), 1.0f);
+	outOutput.Zoom = DequantizeUnit(Values[Field_Zoom]);
+	outOutput.Pan = DequantizeAngle(Values[Field_Pan], Type.fPanRange);
+	outOutput.Tilt = DequantizeAngle(Values[Field_Tilt], Type.fTiltRange);
+	return outOutput;
+}
+
+uint8 FLexyVFXDMXQuantizedOutput::GetChangedMask(const FLexyVFXDMXQuantizedOutput& Other) const
+{
+	uint8 outMask = 0;
+	for (int32 i = 0; i != Field_Count; i++)
+	{
+		if (Values[i] != Other.Values[i])
+			outMask |= 1 << i;
+	}
+	return outMask;
+}
+
+FLexyVFXDMXClusterReplicator::~FLexyVFXDMXClusterReplicator()
+{
+	if (Socket)
+	{
+		Socket->Close();
+		ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Socket);
+		Socket = nullptr;
+	}
+}
+
+bool FLexyVFXDMXClusterReplicator::InitPrimary(const FString& GroupAddress, int32 Port)
+{
+	FIPv4Address GroupIp;
+	if (!FIPv4Address::Parse(GroupAddress, GroupIp))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Invalid DMX cluster address: %s"), *GroupAddress);
+		return false;
+	}
+
+	Socket = FUdpSocketBuilder(TEXT("LexyVFXDMXClusterPrimary"))
+		.AsNonBlocking()
+		.WithMulticastLoopback()
+		.WithMulticastTtl(1)
+		.WithSendBufferSize(2 * 1024 * 1024)
+		.Build();
+
+	GroupAddr = FIPv4Endpoint(GroupIp, Port).ToInternetAddr();
+	Datagram.Reserve(MaxDatagramSize);
+	return Socket != nullptr;
+}
+
+bool FLexyVFXDMXClusterReplicator::InitSecondary(const FString& GroupAddress, int32 Port)
+{
+	FIPv4Address GroupIp;
+	if (!FIPv4Address::Parse(GroupAddress, GroupIp))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Invalid DMX cluster address: %s"), *GroupAddress);
+		return false;
+	}
+
+	// Reusable so several secondaries on one machine can listen on the same port over loopback
+	Socket = FUdpSocketBuilder(TEXT("LexyVFXDMXClusterSecondary"))
+		.AsNonBlocking()
+		.AsReusable()
+		.BoundToPort(Port)
+		.JoinedToGroup(GroupIp)
+		.WithMulticastLoopback()
+		.WithReceiveBufferSize(2 * 1024 * 1024)
+		.Build();
+
+	return Socket != nullptr;
+}
+
+void FLexyVFXDMXClusterReplicator::BeginFrame(uint32 InFrameNumber, bool bFromTimecode, int32 KeyframeInterval)
+{
+	FrameNumber = InFrameNumber;
+	FrameFlags = bFromTimecode ? Flag_Timecode : 0;
+
+	if (FramesSinceKeyframe == 0)
+		FrameFlags |= Flag_Keyframe;
+	FramesSinceKeyframe = (FramesSinceKeyframe + 1) % FMath::Max(KeyframeInterval, 1);
+
+	Datagram.Reset();
+	DatagramRecords = 0;
+	WriteHeader(Datagram, FrameFlags, FrameNumber, DatagramSequence, 0);
+}
+
+void FLexyVFXDMXClusterReplicator::WriteFixture(uint32 FixtureId, const FLexyVFXDMXQuantizedOutput& Quantized)
+{
+	FLexyVFXDMXQuantizedOutput* LastSent = SentState.Find(FixtureId);
+
+	uint8 Mask = (1 << FLexyVFXDMXQuantizedOutput::Field_Count) - 1;
+	if (LastSent && !(FrameFlags & Flag_Keyframe))
+		Mask = Quantized.GetChangedMask(*LastSent);
+
+	if (Mask == 0)
+		return;
+
+	if (Datagram.Num() + LexyVFXDMXClusterReplicator::MaxRecordSize > MaxDatagramSize)
+		FlushDatagram();
+
+	WriteRecord(Datagram, FixtureId, Mask, Quantized);
+	DatagramRecords++;
+	RecordsSent++;
+	SentState.Add(FixtureId, Quantized);
+}
+
+void FLexyVFXDMXClusterReplicator::EndFrame()
+{
+	// Always sent, even without records, so secondaries keep their frame clock running
+	FlushDatagram();
+	FramesSent++;
+}
+
+void FLexyVFXDMXClusterReplicator::FlushDatagram()
+{
+	// Patch the record count into the header written by BeginFrame or the previous flush
+	Datagram[LexyVFXDMXClusterReplicator::HeaderSize - 2] = DatagramRecords & 0xFF;
+	Datagram[LexyVFXDMXClusterReplicator::HeaderSize - 1] = DatagramRecords >> 8;
+
+	int32 bytesSent = 0;
+	if (Socket && GroupAddr.IsValid())
+		Socket->SendTo(Datagram.GetData(), Datagram.Num(), bytesSent, *GroupAddr);
+	BytesSent += bytesSent;
+
+	DatagramSequence++;
+	Datagram.Reset();
+	DatagramRecords = 0;
+	WriteHeader(Datagram, FrameFlags, FrameNumber, DatagramSequence, 0);
+}
+
+void FLexyVFXDMXClusterReplicator::ReceiveFrames()
+{
+	if (!Socket)
+		return;
+
+	TArray<uint8> ReceivedData;
+	TArray<FRecord> Records;
+	TSharedRef<FInternetAddr> Sender = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->CreateInternetAddr();
+	uint32 pendingSize = 0;
+
+	while (Socket->HasPendingData(pendingSize))
+	{
+		ReceivedData.SetNumUninitialized(FMath::Min(pendingSize, 65507u));
+		int32 bytesRead = 0;
+		if (!Socket->RecvFrom(ReceivedData.GetData(), ReceivedData.Num(), bytesRead, *Sender))
+			break;
+		ReceivedData.SetNum(bytesRead, false);
+
+		uint8 Flags;
+		uint32 ReceivedFrame;
+		uint32 ReceivedSequence;
+		Records.Reset();
+		if (!ParseDatagram(ReceivedData, Flags, ReceivedFrame, ReceivedSequence, Records))
+			continue;
+
+		// Signed distances, so the counters may wrap around
+		const int32 sequenceDelta = int32(ReceivedSequence - LastDatagramSequence);
+		const int32 frameDelta = int32(ReceivedFrame - NewestFrame);
+		if (bHasReceivedDatagram && (sequenceDelta < -LexyVFXDMXClusterReplicator::MaxReorderDistance || frameDelta < -LexyVFXDMXClusterReplicator::MaxReorderDistance))
+		{
+			// Frames queued from before would never be reached, or be applied out of turn
+			PendingFrames.Reset();
+			bHasReceivedDatagram = false;
+			Restarts++;
+		}
+
+		if (bHasReceivedDatagram && sequenceDelta > 1)
+			DatagramsLost += sequenceDelta - 1;
+		if (!bHasReceivedDatagram || frameDelta > 0)
+			NewestFrame = ReceivedFrame;
+		LastDatagramSequence = ReceivedSequence;
+		bHasReceivedDatagram = true;
+		DatagramsReceived++;
+
+		PendingFrames.FindOrAdd(ReceivedFrame).Append(Records);
+		bNewestFrameFromTimecode = (Flags & Flag_Timecode) != 0;
+	}
+}
+
+void FLexyVFXDMXClusterReplicator::ConsumeFrames(int64 TargetFrame, bool bBehindNewest, TFunctionRef<void(uint32 FixtureId, const FLexyVFXDMXQuantizedOutput& Quantized)> ApplyFixture)
+{
+	if (bBehindNewest)
+		TargetFrame = int64(NewestFrame) - TargetFrame;
+
+	TArray<uint32> ReadyFrames;
+	for (const TPair<uint32, TArray<FRecord>>& PendingFrame : PendingFrames)
+	{
+		if (PendingFrame.Key <= TargetFrame)
+			ReadyFrames.Add(PendingFrame.Key);
+	}
+	ReadyFrames.Sort();
+
+	TSet<uint32> TouchedFixtures;
+	for (uint32 ReadyFrame : ReadyFrames)
+	{
+		for (const FRecord& Record : PendingFrames.FindChecked(ReadyFrame))
+		{
+			FLexyVFXDMXQuantizedOutput& State = ReceivedState.FindOrAdd(Record.FixtureId);
+			for (int32 i = 0; i != FLexyVFXDMXQuantizedOutput::Field_Count; i++)
+			{
+				if (Record.Mask & (1 << i))
+					State.Values[i] = Record.Output.Values[i];
+			}
+			TouchedFixtures.Add(Record.FixtureId);
+		}
+		PendingFrames.Remove(ReadyFrame);
+		FramesApplied++;
+	}
+
+	// Only the latest state of each fixture is applied, however many frames were consumed
+	for (uint32 FixtureId : TouchedFixtures)
+	{
+		ApplyFixture(FixtureId, ReceivedState.FindChecked(FixtureId));
+	}
+}
+
+void FLexyVFXDMXClusterReplicator::WriteHeader(TArray<uint8>& OutDatagram, uint8 Flags, uint32 InFrameNumber, uint32 InDatagramSequence, uint16 RecordCount)
+{
+	FMemoryWriter Writer(OutDatagram, false, true);
+	Writer.Seek(OutDatagram.Num());
+
+	uint32 outMagic = Magic;
+	uint8 outVersion = Version;
+	Writer << outMagic << outVersion << Flags << InFrameNumber << InDatagramSequence << RecordCount;
+}
+
+void FLexyVFXDMXClusterReplicator::WriteRecord(TArray<uint8>& OutDatagram, uint32 FixtureId, uint8 Mask, const FLexyVFXDMXQuantizedOutput& Output)
+{
+	FMemoryWriter Writer(OutDatagram, false, true);
+	Writer.Seek(OutDatagram.Num());
+
+	Writer << FixtureId << Mask;
+	for (int32 i = 0; i != FLexyVFXDMXQuantizedOutput::Field_Count; i++)
+	{
+		if (Mask & (1 << i))
+		{
+			uint16 Value = Output.Values[i];
+			Writer << Value;
+		}
+	}
+}
+
+bool FLexyVFXDMXClusterReplicator::ParseDatagram(const TArray<uint8>& Data, uint8& OutFlags, uint32& OutFrameNumber, uint32& OutDatagramSequence, TArray<FRecord>& OutRecords)
+{
+	if (Data.Num() < LexyVFXDMXClusterReplicator::HeaderSize)
+		return false;
+
+	FMemoryReader Reader(Data);
+
+	uint32 inMagic;
+	uint8 inVersion;
+	uint16 recordCount;
+	Reader << inMagic << inVersion << OutFlags << OutFrameNumber << OutDatagramSequence << recordCount;
+	if (inMagic != Magic || inVersion != Version)
+		return false;
+
+	OutRecords.Reserve(OutRecords.Num() + recordCount);
+	for (int32 r = 0; r != recordCount; r++)
+	{
+		FRecord Record;
+		Reader << Record.FixtureId << Record.Mask;
+		for (int32 i = 0; i != FLexyVFXDMXQuantizedOutput::Field_Count; i++)
+		{
+			if (Record.Mask & (1 << i))
+				Reader << Record.Output.Values[i];
+		}
+
+		if (Reader.IsError())
+			return false;
+		OutRecords.Add(Record);
+	}
+	return true;
+}
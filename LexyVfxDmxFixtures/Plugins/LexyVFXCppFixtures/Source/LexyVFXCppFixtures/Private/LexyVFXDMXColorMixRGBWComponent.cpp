@@ -2,29 +2,86 @@
 
 
 #include "LexyVFXDMXColorMixRGBWComponent.h"
+#include "LexyVFXDMXFixtureType.h"
+#include "LexyVFXDMXDecoders.h"
 
-void ULexyVFXDMXColorMixRGBWComponent::BeginPlay()
+namespace LexyVFXDMXColorMixRGBWComponent
 {
-	Super::BeginPlay();
-	this->SetParentDMXRef();
-	this->InitDMXFunctionNames(TArray<FName>({ "Red", "Green", "Blue", "White" }));
+	template<EDMXParameterBitDepth BitDepth>
+	struct TColorMixRGBWDecoder
+	{
+		static void Decode(const ULexyVFXDMXFixtureType& Type, const int32 *ChannelValues, const int32 *ChannelIndices, FLexyVFXDMXFixtureOutput& Output)
+		{
+			typedef TLexyVFXDMXDecoder<BitDepth> FDecoder;
 
-	SpotRef_Light = Cast<USpotLightComponent>(this->FindComponentsByName(USpotLightComponent::StaticClass(), TArray<FString>({ "spot" }))[0]);
+			const float fRed = FDecoder::Normalize(ChannelValues[ChannelIndices[0]]);
+			const float fGreen = FDecoder::Normalize(ChannelValues[ChannelIndices[1]]);
+			const float fBlue = FDecoder::Normalize(ChannelValues[ChannelIndices[2]]);
+			const float fWhite = FDecoder::Normalize(ChannelValues[ChannelIndices[3]]);
 
-	SMRef_Beam = Cast<UStaticMeshComponent>(this->FindComponentsByName(UStaticMeshComponent::StaticClass(), TArray<FString>({ "beam" }))[0]);
+			Output.Color = FLinearColor(FMath::Min(fRed + fWhite, 1.0f), FMath::Min(fGreen + fWhite, 1.0f), FMath::Min(fBlue + fWhite, 1.0f), 1.0f);
+		}
+	};
 
-	SMRef_Lens = Cast<UStaticMeshComponent>(this->FindComponentsByName(UStaticMeshComponent::StaticClass(), TArray<FString>({ "lens" }))[0]);
+	static const FName nColorParameter(TEXT("DMX Color"));
+}
+
+void ULexyVFXDMXColorMixRGBWComponent::BindComponents()
+{
+	const ULexyVFXDMXFixtureType *Type = this->GetFixtureType();
+
+	SpotRef_Light = this->FindFirstComponentByName<USpotLightComponent>(Type->SpotSearchNames);
+
+	SMRef_Beam = this->FindFirstComponentByName<UStaticMeshComponent>(Type->BeamSearchNames);
+
+	SMRef_Lens = this->FindFirstComponentByName<UStaticMeshComponent>(Type->LensSearchNames);
+
+	// Recreated for a mesh bound again after a fixture type edit, so parameters don't keep going to the old mesh
+	miBeam = BindDynamicMaterial(SMRef_Beam);
+
+	miLens = BindDynamicMaterial(SMRef_Lens);
+}
+
+FLexyVFXDMXDecodeFunction ULexyVFXDMXColorMixRGBWComponent::SelectDecoder(const ULexyVFXDMXFixtureType& Type) const
+{
+	return LexyVFXDMXDecoders::Select<LexyVFXDMXColorMixRGBWComponent::TColorMixRGBWDecoder>(Type.colorMixRGBWBitDepth);
+}
+
+const TArray<FName>& ULexyVFXDMXColorMixRGBWComponent::GetFunctionNames(const ULexyVFXDMXFixtureType& Type) const
+{
+	return Type.ColorMixRGBWFunctionNames.nDMXComponentFunctions;
+}
 
-	miBeam = SMRef_Beam->CreateDynamicMaterialInstance(0, SMRef_Beam->GetMaterial(0));
+#if WITH_EDITORONLY_DATA
+bool ULexyVFXDMXColorMixRGBWComponent::MigrateDeprecatedConfig(ULexyVFXDMXFixtureType& Type) const
+{
+	if (colorMixRGBWBitDepth_DEPRECATED == Type.colorMixRGBWBitDepth)
+		return false;
 
-	miLens = SMRef_Lens->CreateDynamicMaterialInstance(0, SMRef_Lens->GetMaterial(0));
+	Type.colorMixRGBWBitDepth = colorMixRGBWBitDepth_DEPRECATED;
+	return true;
 }
+#endif
 
-void ULexyVFXDMXColorMixRGBWComponent::UpdateDMX(TMap<FDMXAttributeName, int32> DImapDMXFunctionValues, TArray<FName> nDMXComponentFunctions)
+void ULexyVFXDMXColorMixRGBWComponent::ApplyOutput(const FLexyVFXDMXFixtureOutput& Output)
 {
-	this->UpdateDMXMaterialVectorParameter(miBeam, colorMixRGBWBitDepth, FName("DMX Color"), DImapDMXFunctionValues, this->FunctionNames.nDMXComponentFunctions);
+	using namespace LexyVFXDMXColorMixRGBWComponent;
+
+	if (miBeam)
+		miBeam->SetVectorParameterValue(nColorParameter, Output.Color);
 
-	this->UpdateDMXMaterialVectorParameter(miLens, colorMixRGBWBitDepth, FName("DMX Color"), DImapDMXFunctionValues, this->FunctionNames.nDMXComponentFunctions);
+	if (miLens)
+		miLens->SetVectorParameterValue(nColorParameter, Output.Color);
 
-	this->UpdateDMXLightColor(colorMixRGBWBitDepth, SpotRef_Light, 1.0f, DImapDMXFunctionValues, this->FunctionNames.nDMXComponentFunctions);
-}
\ No newline at end of file
+	if (SpotRef_Light)
+		SpotRef_Light->SetLightColor(Output.Color, false);
+}
+
+void ULexyVFXDMXColorMixRGBWComponent::DescribeBakedTracks(ILexyVFXDMXBakedTracks& Tracks) const
+{
+	using namespace LexyVFXDMXColorMixRGBWComponent;
+
+	Tracks.AddMaterialColor(SMRef_Beam, DynamicMaterialIndex, nColorParameter, [](const FLexyVFXDMXFixtureOutput& Output) { return Output.Color; });
+	Tracks.AddMaterialColor(SMRef_Lens, DynamicMaterialIndex, nColorParameter, [](const FLexyVFXDMXFixtureOutput& Output) { return Output.Color; });
+	Tracks.AddLightColor(SpotRef_Light, [](const FLexyVFXDMXFixtureOutput& Output) { return Output.Color; });
+}
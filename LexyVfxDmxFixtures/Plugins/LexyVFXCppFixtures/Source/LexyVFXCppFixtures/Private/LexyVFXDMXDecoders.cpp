@@ -0,0 +1,112 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "LexyVFXDMXDecoders.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+
+namespace LexyVFXDMXDecoders
+{
+	// The runtime switch and float mapping every helper used before the decoders, kept as the benchmark baseline
+	static float MapRangeSwitched(EDMXParameterBitDepth DMXBitDepth, int32 Value, float RangeMin, float RangeMax)
+	{
+		float fMaxParameterRange;
+
+		switch (DMXBitDepth)
+		{
+		case EDMXParameterBitDepth::BitDepth_8bits:
+			fMaxParameterRange = 255.0f;
+			break;
+		case EDMXParameterBitDepth::BitDepth_16bits:
+			fMaxParameterRange = 65535.0f;
+			break;
+		case EDMXParameterBitDepth::BitDepth_24bits:
+			fMaxParameterRange = 16777215.0f;
+			break;
+		default:
+			fMaxParameterRange = 255.0f;
+			break;
+		}
+
+		return FMath::GetMappedRangeValueClamped(FVector2D(0.0f, fMaxParameterRange), FVector2D(RangeMin, RangeMax), (float)Value);
+	}
+
+	typedef float (*FMapSwitchedFunction)(EDMXParameterBitDepth DMXBitDepth, int32 Value, float RangeMin, float RangeMax);
+
+	typedef float (*FMapValueFunction)(int32 Value, float RangeMin, float RangeMax);
+
+	template<EDMXParameterBitDepth BitDepth>
+	static float MapValue(int32 Value, float RangeMin, float RangeMax)
+	{
+		return TLexyVFXDMXDecoder<BitDepth>::MapRange(Value, RangeMin, RangeMax);
+	}
+
+	// Selected once per bit depth like a component's decoder, then called per value through the pointer
+	static FMapValueFunction SelectMapValue(EDMXParameterBitDepth BitDepth)
+	{
+		switch (BitDepth)
+		{
+		case EDMXParameterBitDepth::BitDepth_16bits:
+			return &MapValue<EDMXParameterBitDepth::BitDepth_16bits>;
+		case EDMXParameterBitDepth::BitDepth_24bits:
+			return &MapValue<EDMXParameterBitDepth::BitDepth_24bits>;
+		default:
+			return &MapValue<EDMXParameterBitDepth::BitDepth_8bits>;
+		}
+	}
+
+	static void Benchmark(const TArray<FString>& Args)
+	{
+		const int32 numValues = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 1 << 20;
+		static const EDMXParameterBitDepth BitDepths[] = { EDMXParameterBitDepth::BitDepth_8bits, EDMXParameterBitDepth::BitDepth_16bits, EDMXParameterBitDepth::BitDepth_24bits };
+		static const TCHAR* BitDepthNames[] = { TEXT("8 bit"), TEXT("16 bit"), TEXT("24 bit") };
+
+		TArray<int32> Values;
+		TArray<float> OutValues;
+		Values.SetNumUninitialized(numValues);
+		OutValues.SetNumUninitialized(numValues);
+		FRandomStream Random(7688);
+
+		UE_LOG(LogTemp, Warning, TEXT("LexyVFX DMX decoder benchmark, %d values mapped to -270-270:"), numValues);
+		for (int32 bitDepthIndex = 0; bitDepthIndex != UE_ARRAY_COUNT(BitDepths); bitDepthIndex++)
+		{
+			// Read through a volatile so the baseline's switch can't be folded away
+			volatile EDMXParameterBitDepth RuntimeBitDepth = BitDepths[bitDepthIndex];
+			const int32 maxValue = RuntimeBitDepth == EDMXParameterBitDepth::BitDepth_24bits ? 0xFFFFFF : RuntimeBitDepth == EDMXParameterBitDepth::BitDepth_16bits ? 0xFFFF : 0xFF;
+			for (int32& Value : Values)
+			{
+				Value = Random.RandRange(0, maxValue);
+			}
+
+			// Both map one value per call through a function pointer, so neither loop is inlined or vectorized
+			// where the other isn't and only the switch and the mapping differ
+			FMapSwitchedFunction volatile MapSwitchedFunction = &MapRangeSwitched;
+			const FMapSwitchedFunction MapSwitched = MapSwitchedFunction;
+			double startSeconds = FPlatformTime::Seconds();
+			for (int32 i = 0; i != numValues; i++)
+			{
+				OutValues[i] = MapSwitched(RuntimeBitDepth, Values[i], -270.0f, 270.0f);
+			}
+			const double switchedSeconds = FPlatformTime::Seconds() - startSeconds;
+			float fChecksum = OutValues[numValues / 2];
+
+			FMapValueFunction volatile MapValueFunction = SelectMapValue(RuntimeBitDepth);
+			const FMapValueFunction MapSpecialized = MapValueFunction;
+			startSeconds = FPlatformTime::Seconds();
+			for (int32 i = 0; i != numValues; i++)
+			{
+				OutValues[i] = MapSpecialized(Values[i], -270.0f, 270.0f);
+			}
+			const double specializedSeconds = FPlatformTime::Seconds() - startSeconds;
+			fChecksum += OutValues[numValues / 2];
+
+			UE_LOG(LogTemp, Warning, TEXT("  %s: switched %.2f ns/value, specialized %.2f ns/value, %.1fx (checksum %f)"), BitDepthNames[bitDepthIndex],
+				switchedSeconds * 1e9 / numValues, specializedSeconds * 1e9 / numValues, switchedSeconds / FMath::Max(specializedSeconds, 1e-9), fChecksum);
+		}
+	}
+
+	static FAutoConsoleCommand BenchmarkCommand(
+		TEXT("LexyVFX.DMX.Decoders.Benchmark"),
+		TEXT("Times the bit depth specialized decoders against the switched float mapping. Optional argument: number of values"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&Benchmark));
+}
@@ -2,29 +2,81 @@
 
 
 #include "LexyVFXDMXDimmerComponent.h"
+#include "LexyVFXDMXFixtureType.h"
+#include "LexyVFXDMXDecoders.h"
 
-void ULexyVFXDMXDimmerComponent::BeginPlay()
+namespace LexyVFXDMXDimmerComponent
 {
-	Super::BeginPlay();
-	this->SetParentDMXRef();
-	this->InitDMXFunctionNames(TArray<FName>({ "Dimmer" }));
+	template<EDMXParameterBitDepth BitDepth>
+	struct TDimmerDecoder
+	{
+		static void Decode(const ULexyVFXDMXFixtureType& Type, const int32 *ChannelValues, const int32 *ChannelIndices, FLexyVFXDMXFixtureOutput& Output)
+		{
+			Output.Dimmer = TLexyVFXDMXDecoder<BitDepth>::Normalize(ChannelValues[ChannelIndices[0]]);
+		}
+	};
 
-	SpotRef_Light = Cast<USpotLightComponent>(this->FindComponentsByName(USpotLightComponent::StaticClass(), TArray<FString>({ "spot" }))[0]);
+	static const FName nDimmerParameter(TEXT("DMX Dimmer"));
+}
+
+void ULexyVFXDMXDimmerComponent::BindComponents()
+{
+	const ULexyVFXDMXFixtureType *Type = this->GetFixtureType();
+
+	SpotRef_Light = this->FindFirstComponentByName<USpotLightComponent>(Type->SpotSearchNames);
+
+	SMRef_Beam = this->FindFirstComponentByName<UStaticMeshComponent>(Type->BeamSearchNames);
 
-	SMRef_Beam = Cast<UStaticMeshComponent>(this->FindComponentsByName(UStaticMeshComponent::StaticClass(), TArray<FString>({ "beam" }))[0]);
+	SMRef_Lens = this->FindFirstComponentByName<UStaticMeshComponent>(Type->LensSearchNames);
+
+	// Recreated for a mesh bound again after a fixture type edit, so parameters don't keep going to the old mesh
+	miBeam = BindDynamicMaterial(SMRef_Beam);
+
+	miLens = BindDynamicMaterial(SMRef_Lens);
+}
+
+FLexyVFXDMXDecodeFunction ULexyVFXDMXDimmerComponent::SelectDecoder(const ULexyVFXDMXFixtureType& Type) const
+{
+	return LexyVFXDMXDecoders::Select<LexyVFXDMXDimmerComponent::TDimmerDecoder>(Type.dimmerBitDepth);
+}
 
-	SMRef_Lens = Cast<UStaticMeshComponent>(this->FindComponentsByName(UStaticMeshComponent::StaticClass(), TArray<FString>({ "lens" }))[0]);
+const TArray<FName>& ULexyVFXDMXDimmerComponent::GetFunctionNames(const ULexyVFXDMXFixtureType& Type) const
+{
+	return Type.DimmerFunctionNames.nDMXComponentFunctions;
+}
 
-	miBeam = SMRef_Beam->CreateDynamicMaterialInstance(0, SMRef_Beam->GetMaterial(0));
+#if WITH_EDITORONLY_DATA
+bool ULexyVFXDMXDimmerComponent::MigrateDeprecatedConfig(ULexyVFXDMXFixtureType& Type) const
+{
+	if (dimmerBitDepth_DEPRECATED == Type.dimmerBitDepth && fLightIntensity_DEPRECATED == Type.fLightIntensity)
+		return false;
 
-	miLens = SMRef_Lens->CreateDynamicMaterialInstance(0, SMRef_Lens->GetMaterial(0));
+	Type.dimmerBitDepth = dimmerBitDepth_DEPRECATED;
+	Type.fLightIntensity = fLightIntensity_DEPRECATED;
+	return true;
 }
+#endif
 
-void ULexyVFXDMXDimmerComponent::UpdateDMX(TMap<FDMXAttributeName, int32> DImapDMXFunctionValues, TArray<FName> nDMXComponentFunctions)
+void ULexyVFXDMXDimmerComponent::ApplyOutput(const FLexyVFXDMXFixtureOutput& Output)
 {
-	this->UpdateDMXMaterialScalarParameter(miBeam, dimmerBitDepth, FName("DMX Dimmer"), 1.0f, 0.0f, 1.0f, DImapDMXFunctionValues, this->FunctionNames.nDMXComponentFunctions[0]);
+	using namespace LexyVFXDMXDimmerComponent;
+
+	if (miBeam)
+		miBeam->SetScalarParameterValue(nDimmerParameter, Output.Dimmer);
 
-	this->UpdateDMXMaterialScalarParameter(miLens, dimmerBitDepth, FName("DMX Dimmer"), 1.0f, 0.0f, 1.0f, DImapDMXFunctionValues, this->FunctionNames.nDMXComponentFunctions[0]);
+	if (miLens)
+		miLens->SetScalarParameterValue(nDimmerParameter, Output.Dimmer);
 
-	this->UpdateDMXLightIntensity(dimmerBitDepth, SpotRef_Light, fLightIntensity, DImapDMXFunctionValues, this->FunctionNames.nDMXComponentFunctions[0]);
-}
\ No newline at end of file
+	if (SpotRef_Light)
+		SpotRef_Light->SetIntensity(this->GetFixtureType()->GetLightIntensity(Output.Dimmer));
+}
+
+void ULexyVFXDMXDimmerComponent::DescribeBakedTracks(ILexyVFXDMXBakedTracks& Tracks) const
+{
+	using namespace LexyVFXDMXDimmerComponent;
+
+	const ULexyVFXDMXFixtureType *Type = this->GetFixtureType();
+	Tracks.AddMaterialScalar(SMRef_Beam, DynamicMaterialIndex, nDimmerParameter, [](const FLexyVFXDMXFixtureOutput& Output) { return Output.Dimmer; });
+	Tracks.AddMaterialScalar(SMRef_Lens, DynamicMaterialIndex, nDimmerParameter, [](const FLexyVFXDMXFixtureOutput& Output) { return Output.Dimmer; });
+	Tracks.AddFloatProperty(SpotRef_Light, GET_MEMBER_NAME_CHECKED(ULightComponentBase, Intensity), [Type](const FLexyVFXDMXFixtureOutput& Output) { return Type->GetLightIntensity(Output.Dimmer); });
+}
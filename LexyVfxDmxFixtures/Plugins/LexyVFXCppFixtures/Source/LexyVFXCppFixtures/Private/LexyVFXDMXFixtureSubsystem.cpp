@@ -0,0 +1,1247 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "LexyVFXDMXFixtureSubsystem.h"
+#include "LexyVFXDMXFunctionManager.h"
+#include "LexyVFXDMXClusterReplicator.h"
+#include "LexyVFXDMXFixtureType.h"
+#include "DMXRuntime/Public/DMXSubsystem.h"
+#include "DMXRuntime/Public/Game/DMXComponent.h"
+#include "DMXRuntime/Public/Library/DMXLibrary.h"
+#include "DMXRuntime/Public/Library/DMXEntityFixturePatch.h"
+#include "DMXRuntime/Public/Library/DMXEntityFixtureType.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+
+namespace LexyVFXDMXFixtureSubsystem
+{
+	static TAutoConsoleVariable<int32> CVarClusterRole(
+		TEXT("LexyVFX.DMX.Cluster.Role"),
+		0,
+		TEXT("0: standalone, every node evaluates DMX itself\n")
+		TEXT("1: primary, evaluates DMX and broadcasts fixture outputs\n")
+		TEXT("2: secondary, applies fixture outputs received from the primary"));
+
+	// Out of range values fall back to standalone, warned about once per value
+	static ELexyVFXDMXClusterRole GetCVarClusterRole()
+	{
+		static int32 invalidRole = 0;
+		const int32 role = CVarClusterRole.GetValueOnGameThread();
+		if (role >= (int32)ELexyVFXDMXClusterRole::ClusterRole_Standalone && role <= (int32)ELexyVFXDMXClusterRole::ClusterRole_Secondary)
+			return (ELexyVFXDMXClusterRole)role;
+
+		if (role != invalidRole)
+			UE_LOG(LogTemp, Warning, TEXT("LexyVFX.DMX.Cluster.Role %d is out of range, using standalone"), role);
+		invalidRole = role;
+		return ELexyVFXDMXClusterRole::ClusterRole_Standalone;
+	}
+
+	static TAutoConsoleVariable<FString> CVarClusterAddress(
+		TEXT("LexyVFX.DMX.Cluster.Address"),
+		TEXT("239.255.76.88"),
+		TEXT("Multicast group the fixture output frames are sent to"));
+
+	static TAutoConsoleVariable<int32> CVarClusterPort(
+		TEXT("LexyVFX.DMX.Cluster.Port"),
+		7688,
+		TEXT("UDP port of the fixture output frames"));
+
+	static TAutoConsoleVariable<int32> CVarClusterKeyframeInterval(
+		TEXT("LexyVFX.DMX.Cluster.KeyframeInterval"),
+		30,
+		TEXT("Number of frames between full fixture output frames"));
+
+	static TAutoConsoleVariable<int32> CVarClusterApplyDelay(
+		TEXT("LexyVFX.DMX.Cluster.ApplyDelay"),
+		2,
+		TEXT("Frames a secondary waits before applying a received frame, to absorb network jitter"));
+
+	static TAutoConsoleVariable<int32> CVarMaxRebindsPerFrame(
+		TEXT("LexyVFX.DMX.MaxRebindsPerFrame"),
+		256,
+		TEXT("Maximum number of fixtures rebound to their patch per frame after a patch or library change"));
+
+	static TAutoConsoleVariable<float> CVarJitterBufferDelay(
+		TEXT("LexyVFX.DMX.JitterBuffer.Delay"),
+		0.0f,
+		TEXT("Milliseconds received DMX is held before it is applied, to line it up with video and absorb network jitter. 0 applies it on receipt"));
+
+	static TAutoConsoleVariable<int32> CVarJitterBufferAlignToTimecode(
+		TEXT("LexyVFX.DMX.JitterBuffer.AlignToTimecode"),
+		1,
+		TEXT("Stamps and releases held DMX on engine timecode when a timecode provider is set"));
+
+	static TAutoConsoleVariable<int32> CVarJitterBufferMaxFramesPerUniverse(
+		TEXT("LexyVFX.DMX.JitterBuffer.MaxFramesPerUniverse"),
+		256,
+		TEXT("Frames the jitter buffer holds per universe before dropping that universe's oldest, 256 covers about 5.8 s of delay at 44 Hz"));
+
+	static TAutoConsoleVariable<int32> CVarMergeMode(
+		TEXT("LexyVFX.DMX.Merge.Mode"),
+		0,
+		TEXT("How universes received from several sources at the same priority are merged, unless set per universe\n")
+		TEXT("0: HTP, highest value wins\n")
+		TEXT("1: LTP, latest change wins"));
+
+	// Out of range values fall back to HTP, warned about once per value
+	static ELexyVFXDMXMergeMode GetCVarMergeMode()
+	{
+		static int32 invalidMode = 0;
+		const int32 mode = CVarMergeMode.GetValueOnGameThread();
+		if (mode >= (int32)ELexyVFXDMXMergeMode::MergeMode_HTP && mode <= (int32)ELexyVFXDMXMergeMode::MergeMode_LTP)
+			return (ELexyVFXDMXMergeMode)mode;
+
+		if (mode != invalidMode)
+			UE_LOG(LogTemp, Warning, TEXT("LexyVFX.DMX.Merge.Mode %d is out of range, using HTP"), mode);
+		invalidMode = mode;
+		return ELexyVFXDMXMergeMode::MergeMode_HTP;
+	}
+
+	static TAutoConsoleVariable<float> CVarMergeSourceTimeout(
+		TEXT("LexyVFX.DMX.Merge.SourceTimeout"),
+		2.5f,
+		TEXT("Seconds without data after which a source drops out of the merge of a universe"));
+
+	static TAutoConsoleVariable<int32> CVarMergeReceiveSenders(
+		TEXT("LexyVFX.DMX.Merge.ReceiveSenders"),
+		0,
+		TEXT("1 receives Art-Net and sACN on sockets of the fixture subsystem's own, merging every Art-Net node and sACN source as a source of its own at its sACN priority.\n")
+		TEXT("0 merges the DMX plugin's input, one source per protocol. Disable the DMX plugin's input when senders unicast, a unicast datagram only reaches one socket"));
+
+	static TAutoConsoleVariable<FString> CVarSharedMemoryName(
+		TEXT("LexyVFX.DMX.SharedMemory.Name"),
+		TEXT(""),
+		TEXT("Name of a shared-memory DMX ring written by a local console process, read as a merge source of the same name. Empty disables it"));
+
+	static const double fSharedMemoryRetrySeconds = 2.0;
+
+	static TAutoConsoleVariable<int32> CVarMaxInitializationsPerFrame(
+		TEXT("LexyVFX.DMX.MaxInitializationsPerFrame"),
+		0,
+		TEXT("Fixtures beginning play are bound and registered at most this many per frame, after their BeginPlay. 0 initializes each fixture in its BeginPlay"));
+
+	static TAutoConsoleVariable<int32> CVarSmoothMotion(
+		TEXT("LexyVFX.DMX.SmoothMotion"),
+		1,
+		TEXT("Moves pan, tilt and zoom of fixture types with bSmoothMotion through their motor model. 0 applies DMX values directly"));
+
+	// Longest step of the motor model, so a hitch doesn't turn into a jump
+	static const float fMaxMotionDeltaTime = 0.25f;
+
+	// Stable across processes loading the same level and across streaming the level out and back in
+	static uint32 GetFixtureId(const AActor *Actor)
+	{
+		return FCrc::StrCrc32(*UWorld::RemovePIEPrefix(Actor->GetPathName()));
+	}
+
+	// True in the BeginPlay of the last of Actor's fixture components, unregistered components never begin play
+	static bool HaveFixtureComponentsBegunPlay(const AActor *Actor)
+	{
+		TInlineComponentArray<UActorComponent*> Components(Actor);
+		for (const UActorComponent* Component : Components)
+		{
+			if ((Component->IsA<ULexyVFXDMXBaseComponent>() || Component->IsA<ULexyVFXDMXFunctionManager>()) && Component->IsRegistered() && !Component->HasBegunPlay())
+				return false;
+		}
+		return true;
+	}
+
+	static uint32 GetComponentBindingKey(UClass *ActorClass, UClass *ComponentType, const TArray<FString>& SearchNames)
+	{
+		uint32 outKey = HashCombine(GetTypeHash(ActorClass), GetTypeHash(ComponentType));
+		for (const FString& SearchName : SearchNames)
+		{
+			outKey = HashCombine(outKey, GetTypeHash(SearchName));
+		}
+		return outKey;
+	}
+
+	static void LogSharedMemoryStats(UWorld *World)
+	{
+		if (ULexyVFXDMXFixtureSubsystem *FixtureSubsystem = ULexyVFXDMXFixtureSubsystem::Get(World))
+			FixtureSubsystem->LogSharedMemoryStats();
+	}
+
+	static FAutoConsoleCommandWithWorld SharedMemoryStatsCommand(
+		TEXT("LexyVFX.DMX.SharedMemory.Stats"),
+		TEXT("Logs frames read from the shared-memory DMX ring"),
+		FConsoleCommandWithWorldDelegate::CreateStatic(&LogSharedMemoryStats));
+
+	static void LogMergeSources(UWorld *World)
+	{
+		if (ULexyVFXDMXFixtureSubsystem *FixtureSubsystem = ULexyVFXDMXFixtureSubsystem::Get(World))
+			FixtureSubsystem->LogMergeSources();
+	}
+
+	static FAutoConsoleCommandWithWorld MergeSourcesCommand(
+		TEXT("LexyVFX.DMX.Merge.Sources"),
+		TEXT("Logs DMX merge sources, their priorities and the universes received from several sources"),
+		FConsoleCommandWithWorldDelegate::CreateStatic(&LogMergeSources));
+
+	static void LogJitterStats(UWorld *World)
+	{
+		if (ULexyVFXDMXFixtureSubsystem *FixtureSubsystem = ULexyVFXDMXFixtureSubsystem::Get(World))
+			FixtureSubsystem->LogJitterStats();
+	}
+
+	static FAutoConsoleCommandWithWorld JitterStatsCommand(
+		TEXT("LexyVFX.DMX.JitterBuffer.Stats"),
+		TEXT("Logs DMX arrival jitter and jitter buffer depth"),
+		FConsoleCommandWithWorldDelegate::CreateStatic(&LogJitterStats));
+
+	static void ResetJitterStats(UWorld *World)
+	{
+		if (ULexyVFXDMXFixtureSubsystem *FixtureSubsystem = ULexyVFXDMXFixtureSubsystem::Get(World))
+			FixtureSubsystem->ResetJitterStats();
+	}
+
+	static FAutoConsoleCommandWithWorld ResetJitterStatsCommand(
+		TEXT("LexyVFX.DMX.JitterBuffer.ResetStats"),
+		TEXT("Resets DMX arrival jitter stats"),
+		FConsoleCommandWithWorldDelegate::CreateStatic(&ResetJitterStats));
+
+	static void RefreshBindings(UWorld *World)
+	{
+		if (ULexyVFXDMXFixtureSubsystem *FixtureSubsystem = ULexyVFXDMXFixtureSubsystem::Get(World))
+			FixtureSubsystem->RequestRebindAll();
+	}
+
+	static FAutoConsoleCommandWithWorld RefreshBindingsCommand(
+		TEXT("LexyVFX.DMX.RefreshBindings"),
+		TEXT("Rebinds every DMX fixture to its patch"),
+		FConsoleCommandWithWorldDelegate::CreateStatic(&RefreshBindings));
+
+	static void LogClusterStats(UWorld *World)
+	{
+		if (ULexyVFXDMXFixtureSubsystem *FixtureSubsystem = ULexyVFXDMXFixtureSubsystem::Get(World))
+			FixtureSubsystem->LogClusterStats();
+	}
+
+	static FAutoConsoleCommandWithWorld ClusterStatsCommand(
+		TEXT("LexyVFX.DMX.Cluster.Stats"),
+		TEXT("Logs fixture output replication stats of this node"),
+		FConsoleCommandWithWorldDelegate::CreateStatic(&LogClusterStats));
+}
+
+ULexyVFXDMXFixtureSubsystem::ULexyVFXDMXFixtureSubsystem()
+{
+}
+
+ULexyVFXDMXFixtureSubsystem::~ULexyVFXDMXFixtureSubsystem()
+{
+}
+
+ULexyVFXDMXFixtureSubsystem* ULexyVFXDMXFixtureSubsystem::Get(const UObject *WorldContextObject)
+{
+	UWorld *World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<ULexyVFXDMXFixtureSubsystem>() : nullptr;
+}
+
+void ULexyVFXDMXFixtureSubsystem::Deinitialize()
+{
+	StopReceivers();
+	Fixtures.Empty();
+	DirtyFixtures.Empty();
+	UniverseFixtures.Empty();
+	PatchFixtures.Empty();
+	RoutedPatches.Empty();
+	PendingRebinds.Empty();
+	PendingInitializations.Empty();
+	DeferredActors.Empty();
+	ComponentBindings.Empty();
+	UniverseBuffers.Empty();
+	FixturesById.Empty();
+	UnloadedOutputs.Empty();
+	Groups.Empty();
+	GroupIndices.Empty();
+	MotionSmoother.Reset();
+	MotionFixtures.Empty();
+
+	for (TPair<TWeakObjectPtr<UDMXLibrary>, FDelegateHandle>& WatchedLibrary : WatchedLibraries)
+	{
+		if (UDMXLibrary *Library = WatchedLibrary.Key.Get())
+			Library->GetOnEntitiesUpdated().Remove(WatchedLibrary.Value);
+	}
+	WatchedLibraries.Empty();
+
+#if WITH_EDITOR
+	FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(ObjectPropertyChangedHandle);
+	ObjectPropertyChangedHandle.Reset();
+#endif
+
+	Super::Deinitialize();
+}
+
+bool ULexyVFXDMXFixtureSubsystem::IsTickable() const
+{
+	return (Fixtures.Num() > 0 || PendingInitializations.Num() > 0 || bStopReceiversPending) && !HasAnyFlags(RF_ClassDefaultObject);
+}
+
+bool ULexyVFXDMXFixtureSubsystem::IsTickableWhenPaused() const
+{
+	// Fixtures of a world that starts paused still initialize, DMX is evaluated once it unpauses
+	return PendingInitializations.Num() > 0 || bStopReceiversPending;
+}
+
+TStatId ULexyVFXDMXFixtureSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(ULexyVFXDMXFixtureSubsystem, STATGROUP_Tickables);
+}
+
+void ULexyVFXDMXFixtureSubsystem::RegisterFixture(ULexyVFXDMXFunctionManager *Fixture)
+{
+	if (!Fixture || Fixtures.Contains(Fixture))
+		return;
+
+	Fixtures.Add(Fixture);
+
+	Fixture->FixtureId = LexyVFXDMXFixtureSubsystem::GetFixtureId(Fixture->GetOwner());
+	if (FixturesById.Contains(Fixture->FixtureId))
+		UE_LOG(LogTemp, Warning, TEXT("DMX fixture id collision between %s and %s"), *Fixture->GetOwner()->GetName(), *FixturesById[Fixture->FixtureId]->GetOwner()->GetName());
+	FixturesById.Add(Fixture->FixtureId, Fixture);
+
+	Fixture->BuildChannelOffsets();
+	RouteFixture(Fixture);
+
+	// A fixture streaming back in shows its last look straight away instead of the defaults
+	FLexyVFXDMXQuantizedOutput UnloadedOutput;
+	if (UnloadedOutputs.RemoveAndCopyValue(Fixture->FixtureId, UnloadedOutput))
+		Fixture->ApplyOutput(UnloadedOutput.Dequantize(*Fixture->GetFixtureType()));
+
+	// Catches up with DMX received before it registered instead of waiting for the next packet
+	if (ClusterRole != ELexyVFXDMXClusterRole::ClusterRole_Secondary && UniverseBuffers.Contains(Fixture->BoundUniverse))
+		MarkFixtureDirty(Fixture);
+
+	Fixture->GroupIndex = INDEX_NONE;
+	if (!Fixture->Group.IsNone())
+	{
+		Fixture->GroupIndex = FindOrAddGroup(Fixture->Group);
+		Groups[Fixture->GroupIndex].GroupFixtures.Add(Fixture);
+	}
+
+	if (bStopReceiversPending)
+	{
+		bStopReceiversPending = false;
+	}
+	else if (Fixtures.Num() == 1)
+	{
+		SetClusterRole(LexyVFXDMXFixtureSubsystem::GetCVarClusterRole());
+#if WITH_EDITOR
+		if (!ObjectPropertyChangedHandle.IsValid())
+			ObjectPropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddUObject(this, &ULexyVFXDMXFixtureSubsystem::OnObjectPropertyChanged);
+#endif
+	}
+}
+
+void ULexyVFXDMXFixtureSubsystem::UnregisterFixture(ULexyVFXDMXFunctionManager *Fixture)
+{
+	Fixtures.Remove(Fixture);
+	DirtyFixtures.Remove(Fixture);
+	PendingRebinds.Remove(Fixture);
+	RemoveMotion(Fixture);
+
+	if (FixturesById.FindRef(Fixture->FixtureId) == Fixture)
+		FixturesById.Remove(Fixture->FixtureId);
+
+	UnrouteFixture(Fixture);
+
+	if (Groups.IsValidIndex(Fixture->GroupIndex))
+		Groups[Fixture->GroupIndex].GroupFixtures.RemoveSwap(Fixture);
+	Fixture->GroupIndex = INDEX_NONE;
+
+	// Deferred to the next tick, so a rig that unregisters all its fixtures and registers them again in one frame
+	// keeps its receivers, cluster role and sockets
+	if (Fixtures.Num() == 0)
+		bStopReceiversPending = true;
+}
+
+void ULexyVFXDMXFixtureSubsystem::StopReceivers()
+{
+	bStopReceiversPending = false;
+	SetReceivingDMX(false);
+	ClusterReplicator.Reset();
+	SharedMemoryReader.Reset();
+	NetworkReceiver.Reset();
+	ClusterRole = ELexyVFXDMXClusterRole::ClusterRole_Standalone;
+	RequestedClusterRole = ELexyVFXDMXClusterRole::ClusterRole_Standalone;
+}
+
+void ULexyVFXDMXFixtureSubsystem::UnloadFixture(ULexyVFXDMXFunctionManager *Fixture)
+{
+	// A moving fixture would have arrived by the time it streams back in
+	const FLexyVFXDMXFixtureOutput& Output = Fixture->MotionIndex != INDEX_NONE ? Fixture->MotionTarget : Fixture->Output;
+	UnloadedOutputs.Add(Fixture->FixtureId, FLexyVFXDMXQuantizedOutput::Quantize(Output, *Fixture->GetFixtureType()));
+
+	UnregisterFixture(Fixture);
+}
+
+void ULexyVFXDMXFixtureSubsystem::MarkFixtureDirty(ULexyVFXDMXFunctionManager *Fixture)
+{
+	Fixture->bDecodeDirty = true;
+	if (!Fixture->bDMXDirty)
+	{
+		Fixture->bDMXDirty = true;
+		DirtyFixtures.Add(Fixture);
+	}
+}
+
+int32 ULexyVFXDMXFixtureSubsystem::FindOrAddGroup(FName Group)
+{
+	if (const int32* GroupIndex = GroupIndices.Find(Group))
+		return *GroupIndex;
+
+	const int32 groupIndex = Groups.AddDefaulted();
+	Groups[groupIndex].Group.Name = Group;
+	GroupIndices.Add(Group, groupIndex);
+	return groupIndex;
+}
+
+void ULexyVFXDMXFixtureSubsystem::SetGroup(const FLexyVFXDMXFixtureGroup& Group)
+{
+	if (Group.Name.IsNone())
+		return;
+
+	const int32 groupIndex = FindOrAddGroup(Group.Name);
+	int32 parentIndex = Group.ParentGroup.IsNone() ? INDEX_NONE : FindOrAddGroup(Group.ParentGroup);
+
+	// A parent chain leading back to the group itself would never resolve
+	for (int32 ancestorIndex = parentIndex; ancestorIndex != INDEX_NONE; ancestorIndex = Groups[ancestorIndex].ParentIndex)
+	{
+		if (ancestorIndex == groupIndex)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("DMX fixture group %s can't be parented to %s, it's one of its children"), *Group.Name.ToString(), *Group.ParentGroup.ToString());
+			parentIndex = Groups[groupIndex].ParentIndex;
+			break;
+		}
+	}
+
+	FGroupState& GroupState = Groups[groupIndex];
+	if (GroupState.ParentIndex != parentIndex)
+	{
+		if (GroupState.ParentIndex != INDEX_NONE)
+			Groups[GroupState.ParentIndex].ChildIndices.Remove(groupIndex);
+		if (parentIndex != INDEX_NONE)
+			Groups[parentIndex].ChildIndices.Add(groupIndex);
+		GroupState.ParentIndex = parentIndex;
+	}
+
+	GroupState.Group = Group;
+	GroupState.Group.ParentGroup = parentIndex != INDEX_NONE ? Groups[parentIndex].Group.Name : NAME_None;
+	MarkGroupDirty(groupIndex);
+}
+
+void ULexyVFXDMXFixtureSubsystem::SetGroupDimmer(FName Group, float Dimmer)
+{
+	const int32 groupIndex = FindOrAddGroup(Group);
+	if (Groups[groupIndex].Group.Dimmer != Dimmer)
+	{
+		Groups[groupIndex].Group.Dimmer = Dimmer;
+		MarkGroupDirty(groupIndex);
+	}
+}
+
+void ULexyVFXDMXFixtureSubsystem::SetGroupColor(FName Group, FLinearColor Color)
+{
+	const int32 groupIndex = FindOrAddGroup(Group);
+	if (Groups[groupIndex].Group.Color != Color)
+	{
+		Groups[groupIndex].Group.Color = Color;
+		MarkGroupDirty(groupIndex);
+	}
+}
+
+void ULexyVFXDMXFixtureSubsystem::SetFixtureGroup(ULexyVFXDMXFunctionManager *Fixture, FName Group)
+{
+	if (!Fixture)
+		return;
+
+	if (Groups.IsValidIndex(Fixture->GroupIndex))
+		Groups[Fixture->GroupIndex].GroupFixtures.RemoveSwap(Fixture);
+
+	Fixture->Group = Group;
+	Fixture->GroupIndex = INDEX_NONE;
+	if (!Fixtures.Contains(Fixture))
+		return;
+
+	if (!Group.IsNone())
+	{
+		Fixture->GroupIndex = FindOrAddGroup(Group);
+		Groups[Fixture->GroupIndex].GroupFixtures.Add(Fixture);
+	}
+
+	if (!Fixture->bDMXDirty)
+	{
+		Fixture->bDMXDirty = true;
+		DirtyFixtures.Add(Fixture);
+	}
+}
+
+void ULexyVFXDMXFixtureSubsystem::MarkGroupDirty(int32 GroupIndex)
+{
+	FGroupState& GroupState = Groups[GroupIndex];
+	GroupState.bResolveDirty = true;
+	bGroupsDirty = true;
+
+	// Only the outputs need combining again, the fixtures' own channels haven't changed
+	for (ULexyVFXDMXFunctionManager* Fixture : GroupState.GroupFixtures)
+	{
+		if (!Fixture->bDMXDirty)
+		{
+			Fixture->bDMXDirty = true;
+			DirtyFixtures.Add(Fixture);
+		}
+	}
+
+	for (int32 childIndex : GroupState.ChildIndices)
+	{
+		MarkGroupDirty(childIndex);
+	}
+}
+
+void ULexyVFXDMXFixtureSubsystem::ResolveGroupMasters()
+{
+	if (!bGroupsDirty)
+		return;
+
+	// Parents are resolved before their children, whatever order they were added in
+	TFunction<void(FGroupState&)> ResolveGroup = [this, &ResolveGroup](FGroupState& GroupState)
+	{
+		if (!GroupState.bResolveDirty)
+			return;
+
+		GroupState.ResolvedDimmer = FMath::Clamp(GroupState.Group.Dimmer, 0.0f, 1.0f);
+		GroupState.ResolvedColor = GroupState.Group.Color;
+		if (GroupState.ParentIndex != INDEX_NONE)
+		{
+			FGroupState& ParentState = Groups[GroupState.ParentIndex];
+			ResolveGroup(ParentState);
+			GroupState.ResolvedDimmer *= ParentState.ResolvedDimmer;
+			GroupState.ResolvedColor *= ParentState.ResolvedColor;
+		}
+		GroupState.bResolveDirty = false;
+	};
+
+	for (FGroupState& GroupState : Groups)
+	{
+		ResolveGroup(GroupState);
+	}
+	bGroupsDirty = false;
+}
+
+void ULexyVFXDMXFixtureSubsystem::ProcessGroupMasters(int32 Universe, const TArray<uint8>& DMXBuffer)
+{
+	for (int32 groupIndex = 0; groupIndex != Groups.Num(); groupIndex++)
+	{
+		const FLexyVFXDMXFixtureGroup& Group = Groups[groupIndex].Group;
+		if (Group.DimmerUniverse == Universe && DMXBuffer.IsValidIndex(Group.DimmerChannel - 1))
+			SetGroupDimmer(Group.Name, DMXBuffer[Group.DimmerChannel - 1] / 255.0f);
+	}
+}
+
+FLexyVFXDMXFixtureOutput ULexyVFXDMXFixtureSubsystem::CombineGroupMasters(const ULexyVFXDMXFunctionManager *Fixture, const FLexyVFXDMXFixtureOutput& DecodedOutput) const
+{
+	FLexyVFXDMXFixtureOutput outOutput = DecodedOutput;
+	if (Groups.IsValidIndex(Fixture->GroupIndex))
+	{
+		const FGroupState& GroupState = Groups[Fixture->GroupIndex];
+		outOutput.Dimmer *= GroupState.ResolvedDimmer;
+		outOutput.Color *= GroupState.ResolvedColor;
+	}
+	return outOutput;
+}
+
+void ULexyVFXDMXFixtureSubsystem::RouteFixture(ULexyVFXDMXFunctionManager *Fixture)
+{
+	UDMXEntityFixturePatch *Patch = Fixture->Patch;
+	if (!Patch)
+		return;
+
+	RoutedPatches.Add(Fixture, Patch);
+	PatchFixtures.FindOrAdd(Patch).AddUnique(Fixture);
+	if (Fixture->BoundUniverse != INDEX_NONE)
+		UniverseFixtures.FindOrAdd(Fixture->BoundUniverse).AddUnique(Fixture);
+
+	WatchLibrary(Patch->GetParentLibrary());
+}
+
+void ULexyVFXDMXFixtureSubsystem::UnrouteFixture(ULexyVFXDMXFunctionManager *Fixture)
+{
+	TWeakObjectPtr<UDMXEntityFixturePatch> Patch;
+	if (!RoutedPatches.RemoveAndCopyValue(Fixture, Patch))
+		return;
+
+	if (TArray<ULexyVFXDMXFunctionManager*>* RoutedFixtures = PatchFixtures.Find(Patch))
+	{
+		RoutedFixtures->RemoveSwap(Fixture);
+		if (RoutedFixtures->Num() == 0)
+			PatchFixtures.Remove(Patch);
+	}
+
+	if (TArray<ULexyVFXDMXFunctionManager*>* RoutedFixtures = UniverseFixtures.Find(Fixture->BoundUniverse))
+		RoutedFixtures->RemoveSwap(Fixture);
+}
+
+void ULexyVFXDMXFixtureSubsystem::RequestRebind(ULexyVFXDMXFunctionManager *Fixture)
+{
+	if (Fixture && Fixtures.Contains(Fixture))
+		PendingRebinds.AddUnique(Fixture);
+}
+
+void ULexyVFXDMXFixtureSubsystem::NotifyPatchChanged(UDMXEntityFixturePatch *Patch)
+{
+	if (const TArray<ULexyVFXDMXFunctionManager*>* RoutedFixtures = PatchFixtures.Find(Patch))
+	{
+		for (ULexyVFXDMXFunctionManager* Fixture : *RoutedFixtures)
+		{
+			RequestRebind(Fixture);
+		}
+	}
+}
+
+void ULexyVFXDMXFixtureSubsystem::RequestRebindAll()
+{
+	for (ULexyVFXDMXFunctionManager* Fixture : Fixtures)
+	{
+		Fixture->RefreshPatch();
+		RequestRebind(Fixture);
+	}
+}
+
+void ULexyVFXDMXFixtureSubsystem::ProcessPendingRebinds()
+{
+	const int32 maxRebinds = FMath::Max(1, LexyVFXDMXFixtureSubsystem::CVarMaxRebindsPerFrame.GetValueOnGameThread());
+	const int32 numRebinds = FMath::Min(maxRebinds, PendingRebinds.Num());
+
+	for (int32 i = 0; i != numRebinds; i++)
+	{
+		ULexyVFXDMXFunctionManager *Fixture = PendingRebinds[i];
+		UnrouteFixture(Fixture);
+		Fixture->BuildChannelOffsets();
+		RouteFixture(Fixture);
+		MarkFixtureDirty(Fixture);
+	}
+	PendingRebinds.RemoveAt(0, numRebinds, false);
+}
+
+bool ULexyVFXDMXFixtureSubsystem::DeferInitialization(AActor *Actor)
+{
+	if (!Actor)
+		return false;
+
+	// Components added to a fixture that already initialized join it straight away
+	const ULexyVFXDMXFunctionManager *FunctionManager = Actor->FindComponentByClass<ULexyVFXDMXFunctionManager>();
+	if (FunctionManager && FunctionManager->bFixtureInitialized)
+		return false;
+
+	// A fixture streaming back in is restored in the BeginPlay of its last component, so its look is back in the
+	// frame it streams in, with all its components bound
+	if (UnloadedOutputs.Contains(LexyVFXDMXFixtureSubsystem::GetFixtureId(Actor)))
+	{
+		if (LexyVFXDMXFixtureSubsystem::HaveFixtureComponentsBegunPlay(Actor))
+			InitializeActor(Actor);
+		return true;
+	}
+
+	if (DeferredActors.Contains(Actor))
+		return true;
+
+	if (LexyVFXDMXFixtureSubsystem::CVarMaxInitializationsPerFrame.GetValueOnGameThread() <= 0)
+		return false;
+
+	DeferredActors.Add(Actor);
+	PendingInitializations.Add(Actor);
+	return true;
+}
+
+void ULexyVFXDMXFixtureSubsystem::ProcessPendingInitializations()
+{
+	const int32 maxInitializations = FMath::Max(1, LexyVFXDMXFixtureSubsystem::CVarMaxInitializationsPerFrame.GetValueOnGameThread());
+
+	int32 numProcessed = 0;
+	for (int32 numInitialized = 0; numProcessed != PendingInitializations.Num() && numInitialized != maxInitializations; numProcessed++)
+	{
+		DeferredActors.Remove(PendingInitializations[numProcessed]);
+
+		AActor *Actor = PendingInitializations[numProcessed].Get();
+		if (!Actor || Actor->IsActorBeingDestroyed() || !Actor->HasActorBegunPlay())
+			continue;
+
+		InitializeActor(Actor);
+		numInitialized++;
+	}
+	PendingInitializations.RemoveAt(0, numProcessed, false);
+}
+
+void ULexyVFXDMXFixtureSubsystem::InitializeActor(AActor *Actor)
+{
+	// Function components first, the manager picks them up with their fixture type and decoder already bound
+	TInlineComponentArray<ULexyVFXDMXBaseComponent*> FunctionComponents(Actor);
+	for (ULexyVFXDMXBaseComponent* FunctionComponent : FunctionComponents)
+	{
+		if (FunctionComponent->HasBegunPlay() && !FunctionComponent->bFunctionInitialized)
+			FunctionComponent->InitializeFunction();
+	}
+
+	ULexyVFXDMXFunctionManager *FunctionManager = Actor->FindComponentByClass<ULexyVFXDMXFunctionManager>();
+	if (FunctionManager && FunctionManager->HasBegunPlay() && !FunctionManager->bFixtureInitialized)
+		FunctionManager->InitializeFixture();
+}
+
+const TArray<FName>* ULexyVFXDMXFixtureSubsystem::FindComponentBinding(UClass *ActorClass, TSubclassOf<UActorComponent> ComponentType, const TArray<FString>& SearchNames) const
+{
+	const FComponentBinding *Binding = ComponentBindings.Find(LexyVFXDMXFixtureSubsystem::GetComponentBindingKey(ActorClass, ComponentType, SearchNames));
+	if (!Binding || Binding->ActorClass.Get() != ActorClass || Binding->ComponentType.Get() != ComponentType.Get() || Binding->SearchNames != SearchNames)
+		return nullptr;
+
+	return &Binding->ComponentNames;
+}
+
+void ULexyVFXDMXFixtureSubsystem::AddComponentBinding(UClass *ActorClass, TSubclassOf<UActorComponent> ComponentType, const TArray<FString>& SearchNames, const TArray<UActorComponent*>& Components)
+{
+	FComponentBinding& Binding = ComponentBindings.Add(LexyVFXDMXFixtureSubsystem::GetComponentBindingKey(ActorClass, ComponentType, SearchNames));
+	Binding.ActorClass = ActorClass;
+	Binding.ComponentType = ComponentType.Get();
+	Binding.SearchNames = SearchNames;
+	Binding.ComponentNames.Reset(Components.Num());
+	for (const UActorComponent* Component : Components)
+	{
+		Binding.ComponentNames.Add(Component->GetFName());
+	}
+}
+
+void ULexyVFXDMXFixtureSubsystem::WatchLibrary(UDMXLibrary *Library)
+{
+	if (!Library || WatchedLibraries.Contains(Library))
+		return;
+
+	WatchedLibraries.Add(Library, Library->GetOnEntitiesUpdated().AddUObject(this, &ULexyVFXDMXFixtureSubsystem::OnLibraryEntitiesUpdated));
+}
+
+void ULexyVFXDMXFixtureSubsystem::OnLibraryEntitiesUpdated(UDMXLibrary *Library)
+{
+	// Only fixtures whose patch now resolves differently are rebound
+	for (TPair<ULexyVFXDMXFunctionManager*, TWeakObjectPtr<UDMXEntityFixturePatch>>& RoutedPatch : RoutedPatches)
+	{
+		ULexyVFXDMXFunctionManager *Fixture = RoutedPatch.Key;
+		const UDMXEntityFixturePatch *Patch = RoutedPatch.Value.Get();
+
+		// A fixture routed under a patch that no longer exists is rebound to whatever its DMX component holds now
+		if (!Patch)
+		{
+			Fixture->RefreshPatch();
+			RequestRebind(Fixture);
+		}
+		else if (Patch->GetParentLibrary() == Library && Fixture->GetBindingSignature() != Fixture->BindingSignature)
+		{
+			RequestRebind(Fixture);
+		}
+	}
+}
+
+#if WITH_EDITOR
+void ULexyVFXDMXFixtureSubsystem::OnObjectPropertyChanged(UObject *Object, FPropertyChangedEvent& PropertyChangedEvent)
+{
+	if (UDMXEntityFixturePatch *Patch = Cast<UDMXEntityFixturePatch>(Object))
+	{
+		NotifyPatchChanged(Patch);
+	}
+	else if (UDMXEntityFixtureType *PatchType = Cast<UDMXEntityFixtureType>(Object))
+	{
+		for (TPair<TWeakObjectPtr<UDMXEntityFixturePatch>, TArray<ULexyVFXDMXFunctionManager*>>& RoutedFixtures : PatchFixtures)
+		{
+			UDMXEntityFixturePatch *Patch = RoutedFixtures.Key.Get();
+			if (Patch && Patch->ParentFixtureTypeTemplate == PatchType)
+				NotifyPatchChanged(Patch);
+		}
+	}
+	else if (UDMXComponent *ChangedDMXComp = Cast<UDMXComponent>(Object))
+	{
+		for (ULexyVFXDMXFunctionManager* Fixture : Fixtures)
+		{
+			if (Fixture->DMXComp == ChangedDMXComp)
+			{
+				Fixture->RefreshPatch();
+				RequestRebind(Fixture);
+			}
+		}
+	}
+	else if (ULexyVFXDMXFixtureType *FixtureType = Cast<ULexyVFXDMXFixtureType>(Object))
+	{
+		// Search names or bit depths may have changed, bindings to the actor's components and decoders are resolved again
+		for (ULexyVFXDMXFunctionManager* Fixture : Fixtures)
+		{
+			bool bUsesFixtureType = false;
+			for (ULexyVFXDMXBaseComponent* FunctionComponent : Fixture->LexyVFXFunctionComponents)
+			{
+				if (FunctionComponent->GetFixtureType() == FixtureType)
+				{
+					FunctionComponent->BindComponents();
+					FunctionComponent->BindDecoder();
+					bUsesFixtureType = true;
+				}
+			}
+
+			if (bUsesFixtureType)
+				MarkFixtureDirty(Fixture);
+		}
+	}
+}
+#endif
+
+void ULexyVFXDMXFixtureSubsystem::ProcessDMX(FDMXProtocolName Protocol, int32 Universe, const TArray<uint8>& DMXBuffer)
+{
+	// The same packets arrive per sender through the network receiver
+	if (NetworkReceiver.IsValid() && NetworkReceiver->IsOpen())
+		return;
+
+	// The DMX subsystem doesn't tell senders apart, each protocol is a merge source
+	ProcessSourceDMX(Protocol.Name, Universe, DMXBuffer);
+}
+
+void ULexyVFXDMXFixtureSubsystem::ProcessSourceDMX(FName Source, int32 Universe, const TArray<uint8>& DMXBuffer)
+{
+	ReceiveSourceDMX(Source, Universe, DMXBuffer);
+}
+
+void ULexyVFXDMXFixtureSubsystem::ReceiveSourceDMX(FName Source, int32 Universe, TArrayView<const uint8> DMXBuffer)
+{
+	const double arrivalSeconds = FPlatformTime::Seconds();
+	JitterBuffer.RecordArrival(Source, Universe, arrivalSeconds);
+
+	// Only frames that change the merged universe go any further
+	MergeEngine.DefaultMode = LexyVFXDMXFixtureSubsystem::GetCVarMergeMode();
+	MergeEngine.SourceTimeout = LexyVFXDMXFixtureSubsystem::CVarMergeSourceTimeout.GetValueOnGameThread();
+	if (const TArray<uint8>* MergedBuffer = MergeEngine.Receive(Source, Universe, DMXBuffer, arrivalSeconds))
+		ReceiveUniverse(Universe, *MergedBuffer);
+}
+
+void ULexyVFXDMXFixtureSubsystem::PollNetwork()
+{
+	if (LexyVFXDMXFixtureSubsystem::CVarMergeReceiveSenders.GetValueOnGameThread() == 0)
+	{
+		NetworkReceiver.Reset();
+		return;
+	}
+
+	if (!NetworkReceiver.IsValid())
+	{
+		NetworkReceiver = MakeUnique<FLexyVFXDMXNetworkReceiver>();
+		if (NetworkReceiver->Open())
+			UE_LOG(LogTemp, Log, TEXT("Receiving Art-Net and sACN per sender"));
+	}
+
+	if (!NetworkReceiver->IsOpen())
+		return;
+
+	for (const TPair<int32, TArray<ULexyVFXDMXFunctionManager*>>& Universe : UniverseFixtures)
+	{
+		NetworkReceiver->JoinSACNUniverse(Universe.Key);
+	}
+
+	NetworkReceiver->Poll([this](FName Source, int32 Priority, int32 Universe, TArrayView<const uint8> DMXBuffer)
+	{
+		if (Priority != INDEX_NONE)
+			MergeEngine.SetSourcePriority(Source, Priority);
+		ReceiveSourceDMX(Source, Universe, DMXBuffer);
+	});
+}
+
+void ULexyVFXDMXFixtureSubsystem::SetSourcePriority(FName Source, int32 Priority)
+{
+	MergeEngine.SetSourcePriority(Source, Priority);
+}
+
+void ULexyVFXDMXFixtureSubsystem::SetUniverseMergeMode(int32 Universe, ELexyVFXDMXMergeMode Mode)
+{
+	MergeEngine.SetUniverseMergeMode(Universe, Mode);
+}
+
+void ULexyVFXDMXFixtureSubsystem::LogMergeSources() const
+{
+	MergeEngine.LogSources();
+	if (NetworkReceiver.IsValid() && NetworkReceiver->IsOpen())
+		UE_LOG(LogTemp, Warning, TEXT("  received per sender: %llu packets, %llu ignored"), NetworkReceiver->PacketsRead, NetworkReceiver->PacketsIgnored);
+}
+
+void ULexyVFXDMXFixtureSubsystem::PollSharedMemory()
+{
+	const FString RegionName = LexyVFXDMXFixtureSubsystem::CVarSharedMemoryName.GetValueOnGameThread();
+	if (RegionName.IsEmpty())
+	{
+		SharedMemoryReader.Reset();
+		return;
+	}
+
+	if (!SharedMemoryReader.IsValid() || SharedMemoryReader->GetRegionName() != RegionName)
+	{
+		SharedMemoryReader = MakeUnique<FLexyVFXDMXSharedMemoryReader>();
+		NextSharedMemoryOpenTime = 0.0;
+		bSharedMemoryOpenFailed = false;
+	}
+
+	// The writer may start after us or restart, opening is retried every few seconds
+	const double now = FPlatformTime::Seconds();
+	if (!SharedMemoryReader->IsOpen())
+	{
+		if (now < NextSharedMemoryOpenTime)
+			return;
+
+		NextSharedMemoryOpenTime = now + LexyVFXDMXFixtureSubsystem::fSharedMemoryRetrySeconds;
+		if (!SharedMemoryReader->Open(RegionName))
+		{
+			if (!bSharedMemoryOpenFailed)
+				UE_LOG(LogTemp, Warning, TEXT("Couldn't open DMX shared memory %s, retrying"), *RegionName);
+			bSharedMemoryOpenFailed = true;
+			return;
+		}
+		UE_LOG(LogTemp, Warning, TEXT("Reading DMX from shared memory %s"), *RegionName);
+		bSharedMemoryOpenFailed = false;
+		LastSharedMemoryFrameTime = now;
+	}
+
+	const FName Source(*RegionName);
+	const int32 numRead = SharedMemoryReader->Poll([this, Source](int32 Universe, TArrayView<const uint8> DMXBuffer)
+	{
+		ReceiveSourceDMX(Source, Universe, DMXBuffer);
+	});
+
+	// A writer that went quiet may have recreated the region, it's mapped again
+	if (numRead > 0)
+		LastSharedMemoryFrameTime = now;
+	else if (now - LastSharedMemoryFrameTime > LexyVFXDMXFixtureSubsystem::fSharedMemoryRetrySeconds)
+		SharedMemoryReader->Close();
+}
+
+void ULexyVFXDMXFixtureSubsystem::LogSharedMemoryStats() const
+{
+	if (!SharedMemoryReader.IsValid() || !SharedMemoryReader->IsOpen())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("LexyVFX DMX shared memory: not open"));
+		return;
+	}
+
+	const FLexyVFXDMXSharedMemoryReader& Reader = *SharedMemoryReader;
+	UE_LOG(LogTemp, Warning, TEXT("LexyVFX DMX shared memory %s: frames read: %llu, skipped: %llu, torn: %llu"), *Reader.GetRegionName(), Reader.FramesRead, Reader.FramesSkipped, Reader.FramesTorn);
+}
+
+void ULexyVFXDMXFixtureSubsystem::ReceiveUniverse(int32 Universe, const TArray<uint8>& DMXBuffer)
+{
+	const float fDelayMs = LexyVFXDMXFixtureSubsystem::CVarJitterBufferDelay.GetValueOnGameThread();
+	if (fDelayMs > 0.0f)
+	{
+		JitterBuffer.MaxFramesPerUniverse = LexyVFXDMXFixtureSubsystem::CVarJitterBufferMaxFramesPerUniverse.GetValueOnGameThread();
+		JitterBuffer.Push(Universe, DMXBuffer, GetJitterClock());
+		return;
+	}
+
+	// Frames held from before the jitter buffer was turned off go first
+	JitterBuffer.Flush([this](int32 BufferedUniverse, const TArray<uint8>& BufferedDMX)
+	{
+		ApplyUniverse(BufferedUniverse, BufferedDMX);
+	});
+	ApplyUniverse(Universe, DMXBuffer);
+}
+
+double ULexyVFXDMXFixtureSubsystem::GetJitterClock() const
+{
+	if (LexyVFXDMXFixtureSubsystem::CVarJitterBufferAlignToTimecode.GetValueOnGameThread() != 0 && GEngine && GEngine->GetTimecodeProvider())
+	{
+		const FFrameRate TimecodeRate = FApp::GetTimecodeFrameRate();
+		return TimecodeRate.AsSeconds(FFrameTime(FApp::GetTimecode().ToFrameNumber(TimecodeRate)));
+	}
+	return FPlatformTime::Seconds();
+}
+
+void ULexyVFXDMXFixtureSubsystem::ReleaseJitterBuffer()
+{
+	if (JitterBuffer.IsEmpty())
+		return;
+
+	// A frame is released once the clock is past its stamp plus the delay, turning the delay off releases everything
+	const double delaySeconds = LexyVFXDMXFixtureSubsystem::CVarJitterBufferDelay.GetValueOnGameThread() / 1000.0;
+	const double releaseTime = delaySeconds > 0.0 ? GetJitterClock() - delaySeconds : TNumericLimits<double>::Max();
+	JitterBuffer.Release(releaseTime, [this](int32 Universe, const TArray<uint8>& DMXBuffer)
+	{
+		ApplyUniverse(Universe, DMXBuffer);
+	});
+}
+
+FLexyVFXDMXJitterStats ULexyVFXDMXFixtureSubsystem::GetJitterStats() const
+{
+	return JitterBuffer.GetStats(FMath::Max(LexyVFXDMXFixtureSubsystem::CVarJitterBufferDelay.GetValueOnGameThread(), 0.0f));
+}
+
+void ULexyVFXDMXFixtureSubsystem::ResetJitterStats()
+{
+	JitterBuffer.ResetStats();
+}
+
+void ULexyVFXDMXFixtureSubsystem::LogJitterStats() const
+{
+	const FLexyVFXDMXJitterStats Stats = GetJitterStats();
+	UE_LOG(LogTemp, Warning, TEXT("LexyVFX DMX jitter buffer: delay %.1f ms, interval %.2f ms, jitter %.2f ms (max %.2f ms)"), Stats.DelayMs, Stats.IntervalMs, Stats.JitterMs, Stats.MaxJitterMs);
+	UE_LOG(LogTemp, Warning, TEXT("  depth %d (max %d), frames released: %lld, dropped: %lld"), Stats.BufferDepth, Stats.MaxBufferDepth, Stats.FramesReleased, Stats.FramesDropped);
+}
+
+void ULexyVFXDMXFixtureSubsystem::ApplyUniverse(int32 Universe, const TArray<uint8>& DMXBuffer)
+{
+	UniverseBuffers.FindOrAdd(Universe) = DMXBuffer;
+
+	if (Groups.Num() > 0)
+		ProcessGroupMasters(Universe, DMXBuffer);
+
+	if (const TArray<ULexyVFXDMXFunctionManager*>* PatchedFixtures = UniverseFixtures.Find(Universe))
+	{
+		for (ULexyVFXDMXFunctionManager* Fixture : *PatchedFixtures)
+		{
+			MarkFixtureDirty(Fixture);
+		}
+	}
+}
+
+void ULexyVFXDMXFixtureSubsystem::SetReceivingDMX(bool bReceive)
+{
+	if (bReceivingDMX == bReceive)
+		return;
+
+	UDMXSubsystem *UnrealDMXSubsystem = UDMXSubsystem::GetDMXSubsystem_Pure();
+	if (!UnrealDMXSubsystem)
+		return;
+
+	// Using OnProtocolReceived_Deprecated until the DMXComponent's OnPatchReceived is made Public in 4.26.1
+	if (bReceive)
+	{
+		ReceivedDMX.BindUFunction(this, "ProcessDMX");
+		UnrealDMXSubsystem->OnProtocolReceived_DEPRECATED.Add(ReceivedDMX);
+	}
+	else
+	{
+		UnrealDMXSubsystem->OnProtocolReceived_DEPRECATED.Remove(ReceivedDMX);
+	}
+	bReceivingDMX = bReceive;
+}
+
+void ULexyVFXDMXFixtureSubsystem::SetClusterRole(ELexyVFXDMXClusterRole NewRole)
+{
+	RequestedClusterRole = NewRole;
+	ClusterRole = NewRole;
+	ClusterReplicator.Reset();
+
+	const FString GroupAddress = LexyVFXDMXFixtureSubsystem::CVarClusterAddress.GetValueOnGameThread();
+	const int32 port = LexyVFXDMXFixtureSubsystem::CVarClusterPort.GetValueOnGameThread();
+
+	if (ClusterRole != ELexyVFXDMXClusterRole::ClusterRole_Standalone)
+	{
+		ClusterReplicator = MakeUnique<FLexyVFXDMXClusterReplicator>();
+		const bool bInitialized = ClusterRole == ELexyVFXDMXClusterRole::ClusterRole_Primary ? ClusterReplicator->InitPrimary(GroupAddress, port) : ClusterReplicator->InitSecondary(GroupAddress, port);
+		if (!bInitialized)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Couldn't open DMX cluster socket on %s:%d, running standalone"), *GroupAddress, port);
+			ClusterReplicator.Reset();
+			ClusterRole = ELexyVFXDMXClusterRole::ClusterRole_Standalone;
+		}
+	}
+
+	// Secondaries only apply what the primary evaluated
+	SetReceivingDMX(ClusterRole != ELexyVFXDMXClusterRole::ClusterRole_Secondary);
+	if (ClusterRole == ELexyVFXDMXClusterRole::ClusterRole_Secondary)
+		NetworkReceiver.Reset();
+}
+
+void ULexyVFXDMXFixtureSubsystem::Tick(float DeltaTime)
+{
+	ProcessPendingInitializations();
+
+	if (bStopReceiversPending)
+		StopReceivers();
+
+	const UWorld *World = GetWorld();
+	if (World && World->IsPaused())
+		return;
+
+	const ELexyVFXDMXClusterRole CVarRole = LexyVFXDMXFixtureSubsystem::GetCVarClusterRole();
+	if (CVarRole != RequestedClusterRole)
+		SetClusterRole(CVarRole);
+
+	if (ClusterRole == ELexyVFXDMXClusterRole::ClusterRole_Secondary)
+	{
+		ApplyClusterFrames();
+		return;
+	}
+
+	PollSharedMemory();
+	PollNetwork();
+	MergeEngine.Update(FPlatformTime::Seconds(), [this](int32 Universe, const TArray<uint8>& DMXBuffer)
+	{
+		ReceiveUniverse(Universe, DMXBuffer);
+	});
+	ReleaseJitterBuffer();
+	ProcessPendingRebinds();
+	EvaluateDirtyFixtures();
+	UpdateMotion(DeltaTime);
+
+	if (ClusterRole == ELexyVFXDMXClusterRole::ClusterRole_Primary)
+		SendClusterFrame();
+
+	UpdateCount++;
+}
+
+void ULexyVFXDMXFixtureSubsystem::EvaluateDirtyFixtures()
+{
+	ResolveGroupMasters();
+
+	const bool bSmoothMotion = LexyVFXDMXFixtureSubsystem::CVarSmoothMotion.GetValueOnGameThread() != 0;
+
+	for (ULexyVFXDMXFunctionManager* Fixture : DirtyFixtures)
+	{
+		Fixture->bDMXDirty = false;
+		if (Fixture->bDecodeDirty)
+		{
+			Fixture->bDecodeDirty = false;
+			if (const TArray<uint8>* DMXBuffer = UniverseBuffers.Find(Fixture->BoundUniverse))
+				Fixture->DecodeUniverse(*DMXBuffer);
+		}
+		if (bSmoothMotion && Fixture->GetFixtureType()->bSmoothMotion)
+			SetMotionTarget(Fixture, CombineGroupMasters(Fixture, Fixture->DecodedOutput));
+		else
+		{
+			RemoveMotion(Fixture);
+			Fixture->ApplyOutput(CombineGroupMasters(Fixture, Fixture->DecodedOutput));
+		}
+	}
+	DirtyFixtures.Reset();
+}
+
+void ULexyVFXDMXFixtureSubsystem::SetMotionTarget(ULexyVFXDMXFunctionManager *Fixture, const FLexyVFXDMXFixtureOutput& Output)
+{
+	// Dimmer and color aren't motorized and follow DMX straight away
+	Fixture->MotionTarget = Output;
+	if (Fixture->MotionIndex == INDEX_NONE)
+	{
+		Fixture->MotionIndex = MotionSmoother.AddSlot(FVector4(Fixture->Output.Pan, Fixture->Output.Tilt, Fixture->Output.Zoom, 0.0f));
+		MotionFixtures.Add(Fixture);
+	}
+
+	const ULexyVFXDMXFixtureType *FixtureType = Fixture->GetFixtureType();
+	MotionSmoother.SetTarget(Fixture->MotionIndex, FVector4(Output.Pan, Output.Tilt, Output.Zoom, 0.0f), FixtureType->GetMotionMaxSpeeds(), FixtureType->GetMotionMaxAccelerations());
+}
+
+void ULexyVFXDMXFixtureSubsystem::RemoveMotion(ULexyVFXDMXFunctionManager *Fixture)
+{
+	const int32 motionIndex = Fixture->MotionIndex;
+	if (motionIndex == INDEX_NONE)
+		return;
+
+	MotionSmoother.RemoveSlot(motionIndex);
+	MotionFixtures.RemoveAtSwap(motionIndex, 1, false);
+	if (MotionFixtures.IsValidIndex(motionIndex))
+		MotionFixtures[motionIndex]->MotionIndex = motionIndex;
+	Fixture->MotionIndex = INDEX_NONE;
+}
+
+void ULexyVFXDMXFixtureSubsystem::UpdateMotion(float DeltaTime)
+{
+	if (MotionFixtures.Num() == 0)
+		return;
+
+	if (LexyVFXDMXFixtureSubsystem::CVarSmoothMotion.GetValueOnGameThread() == 0)
+	{
+		SettleMotion();
+		return;
+	}
+
+	MotionSmoother.Step(FMath::Min(DeltaTime, LexyVFXDMXFixtureSubsystem::fMaxMotionDeltaTime));
+
+	// Backwards, so settled fixtures can be swapped out while iterating
+	for (int32 motionIndex = MotionFixtures.Num() - 1; motionIndex >= 0; motionIndex--)
+	{
+		ULexyVFXDMXFunctionManager *Fixture = MotionFixtures[motionIndex];
+		const FVector4& Position = MotionSmoother.GetPosition(motionIndex);
+
+		FLexyVFXDMXFixtureOutput Output = Fixture->MotionTarget;
+		Output.Pan = Position[FLexyVFXDMXMotionSmoother::Axis_Pan];
+		Output.Tilt = Position[FLexyVFXDMXMotionSmoother::Axis_Tilt];
+		Output.Zoom = Position[FLexyVFXDMXMotionSmoother::Axis_Zoom];
+		Fixture->ApplyOutput(Output);
+
+		if (MotionSmoother.IsSettled(motionIndex))
+			RemoveMotion(Fixture);
+	}
+}
+
+void ULexyVFXDMXFixtureSubsystem::SettleMotion()
+{
+	for (ULexyVFXDMXFunctionManager* Fixture : MotionFixtures)
+	{
+		Fixture->MotionIndex = INDEX_NONE;
+		Fixture->ApplyOutput(Fixture->MotionTarget);
+	}
+	MotionFixtures.Reset();
+	MotionSmoother.Reset();
+}
+
+uint32 ULexyVFXDMXFixtureSubsystem::GetClusterFrameNumber(bool& bOutFromTimecode) const
+{
+	bOutFromTimecode = GEngine && GEngine->GetTimecodeProvider() != nullptr;
+	if (bOutFromTimecode)
+		return (uint32)FApp::GetTimecode().ToFrameNumber(FApp::GetTimecodeFrameRate()).Value;
+
+	return UpdateCount;
+}
+
+void ULexyVFXDMXFixtureSubsystem::SendClusterFrame()
+{
+	bool bFromTimecode;
+	const uint32 frameNumber = GetClusterFrameNumber(bFromTimecode);
+
+	ClusterReplicator->BeginFrame(frameNumber, bFromTimecode, LexyVFXDMXFixtureSubsystem::CVarClusterKeyframeInterval.GetValueOnGameThread());
+	for (const ULexyVFXDMXFunctionManager* Fixture : Fixtures)
+	{
+		ClusterReplicator->WriteFixture(Fixture->FixtureId, FLexyVFXDMXQuantizedOutput::Quantize(Fixture->Output, *Fixture->GetFixtureType()));
+	}
+	ClusterReplicator->EndFrame();
+}
+
+void ULexyVFXDMXFixtureSubsystem::ApplyClusterFrames()
+{
+	ClusterReplicator->ReceiveFrames();
+
+	// With a shared timecode every node applies the same frame on the same rendered frame,
+	// otherwise frames are applied a fixed number of frames behind the newest one received
+	const int32 applyDelay = LexyVFXDMXFixtureSubsystem::CVarClusterApplyDelay.GetValueOnGameThread();
+	bool bFromTimecode;
+	const uint32 localFrame = GetClusterFrameNumber(bFromTimecode);
+	const bool bAlignToTimecode = bFromTimecode && ClusterReplicator->IsNewestFrameFromTimecode();
+	const int64 targetFrame = bAlignToTimecode ? int64(localFrame) - applyDelay : applyDelay;
+
+	ClusterReplicator->ConsumeFrames(targetFrame, !bAlignToTimecode, [this](uint32 FixtureId, const FLexyVFXDMXQuantizedOutput& Quantized)
+	{
+		if (ULexyVFXDMXFunctionManager* Fixture = FixturesById.FindRef(FixtureId))
+			Fixture->ApplyOutput(Quantized.Dequantize(*Fixture->GetFixtureType()));
+		else if (FLexyVFXDMXQuantizedOutput* UnloadedOutput = UnloadedOutputs.Find(FixtureId))
+			*UnloadedOutput = Quantized;
+	});
+}
+
+void ULexyVFXDMXFixtureSubsystem::LogClusterStats() const
+{
+	static const TCHAR* RoleNames[] = { TEXT("standalone"), TEXT("primary"), TEXT("secondary") };
+	UE_LOG(LogTemp, Warning, TEXT("LexyVFX DMX cluster: %s, %d fixtures, %d streamed out"), RoleNames[(uint8)ClusterRole], Fixtures.Num(), UnloadedOutputs.Num());
+
+	if (!ClusterReplicator.IsValid())
+		return;
+
+	const FLexyVFXDMXClusterReplicator& Replicator = *ClusterReplicator;
+	if (ClusterRole == ELexyVFXDMXClusterRole::ClusterRole_Primary)
+	{
+		const double framesSent = FMath::Max<double>(Replicator.FramesSent, 1);
+		UE_LOG(LogTemp, Warning, TEXT("  frames sent: %llu, %.1f bytes/frame, %.1f fixtures/frame"), Replicator.FramesSent, Replicator.BytesSent / framesSent, Replicator.RecordsSent / framesSent);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Warning, TEXT("  frames applied: %llu, datagrams received: %llu, lost: %llu, restarts: %llu"), Replicator.FramesApplied, Replicator.DatagramsReceived, Replicator.DatagramsLost, Replicator.Restarts);
+	}
+}
@@ -0,0 +1,145 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "LexyVFXDMXFixtureType.h"
+#include "LexyVFXDMXFunctionManager.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UObjectIterator.h"
+
+namespace LexyVFXDMXFixtureTypeMemory
+{
+	static SIZE_T GetPropertyBytes(const FProperty *Property, const void *ValuePtr)
+	{
+		SIZE_T outBytes = Property->GetSize();
+
+		if (const FArrayProperty *ArrayProperty = CastField<FArrayProperty>(Property))
+		{
+			FScriptArrayHelper ArrayHelper(ArrayProperty, ValuePtr);
+			for (int32 i = 0; i != ArrayHelper.Num(); i++)
+			{
+				outBytes += GetPropertyBytes(ArrayProperty->Inner, ArrayHelper.GetRawPtr(i));
+			}
+		}
+		else if (const FStrProperty *StrProperty = CastField<FStrProperty>(Property))
+		{
+			outBytes += StrProperty->GetPropertyValue(ValuePtr).GetCharArray().GetAllocatedSize();
+		}
+		else if (const FStructProperty *StructProperty = CastField<FStructProperty>(Property))
+		{
+			for (TFieldIterator<FProperty> It(StructProperty->Struct); It; ++It)
+			{
+				// Inline size is already part of the struct, only count what lives on the heap
+				outBytes += GetPropertyBytes(*It, It->ContainerPtrToValuePtr<void>(ValuePtr)) - It->GetSize();
+			}
+		}
+
+		return outBytes;
+	}
+
+	static void LogMemoryReport(UWorld *World)
+	{
+		TMap<const ULexyVFXDMXFixtureType*, int32> FixturesPerType;
+		int32 fixtureCount = 0;
+		SIZE_T instanceBytes = 0;
+
+		for (TObjectIterator<ULexyVFXDMXFunctionManager> It; It; ++It)
+		{
+			ULexyVFXDMXFunctionManager *Manager = *It;
+			if (Manager->GetWorld() != World)
+				continue;
+
+			fixtureCount++;
+			instanceBytes += Manager->GetClass()->GetStructureSize();
+			FixturesPerType.FindOrAdd(Manager->GetFixtureType())++;
+
+			for (ULexyVFXDMXBaseComponent* functionComponent : Manager->LexyVFXFunctionComponents)
+			{
+				if (functionComponent)
+					instanceBytes += functionComponent->GetClass()->GetStructureSize();
+			}
+		}
+
+		if (fixtureCount == 0)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("LexyVFX DMX memory report: no fixtures in world"));
+			return;
+		}
+
+		// The per-fixture config layout is gone and can't be measured. It's estimated as one copy of the full shared
+		// config per fixture on top of today's instance sizes, not the old component layouts byte for byte.
+		SIZE_T legacyConfigBytes = 0;
+		SIZE_T sharedConfigBytes = 0;
+		for (const TPair<const ULexyVFXDMXFixtureType*, int32>& TypeCount : FixturesPerType)
+		{
+			const SIZE_T typeBytes = TypeCount.Key->GetSharedConfigBytes();
+			legacyConfigBytes += typeBytes * TypeCount.Value;
+			sharedConfigBytes += typeBytes;
+		}
+
+		const double beforeBytesPerFixture = double(instanceBytes + legacyConfigBytes) / fixtureCount;
+		const double afterBytesPerFixture = double(instanceBytes + sharedConfigBytes) / fixtureCount;
+
+		UE_LOG(LogTemp, Warning, TEXT("LexyVFX DMX memory report: %d fixtures, %d fixture types"), fixtureCount, FixturesPerType.Num());
+		UE_LOG(LogTemp, Warning, TEXT("  per-instance state: %.1f bytes/fixture"), double(instanceBytes) / fixtureCount);
+		UE_LOG(LogTemp, Warning, TEXT("  estimated with config copied per fixture: %.1f bytes/fixture"), beforeBytesPerFixture);
+		UE_LOG(LogTemp, Warning, TEXT("  measured with shared fixture types: %.1f bytes/fixture"), afterBytesPerFixture);
+		UE_LOG(LogTemp, Warning, TEXT("  estimated saving: %.1f KB total"), double(legacyConfigBytes - sharedConfigBytes) / 1024.0);
+	}
+
+	static FAutoConsoleCommandWithWorld MemReportCommand(
+		TEXT("LexyVFX.DMX.MemReport"),
+		TEXT("Logs bytes per fixture for per-instance state and shared fixture type definitions, against an estimate of the config copied per fixture"),
+		FConsoleCommandWithWorldDelegate::CreateStatic(&LogMemoryReport));
+}
+
+ULexyVFXDMXFixtureType::ULexyVFXDMXFixtureType()
+{
+	DimmerFunctionNames.nDMXComponentFunctions = { "Dimmer" };
+	ColorMixRGBWFunctionNames.nDMXComponentFunctions = { "Red", "Green", "Blue", "White" };
+	PanFunctionNames.nDMXComponentFunctions = { "Pan" };
+	TiltFunctionNames.nDMXComponentFunctions = { "Tilt" };
+	ZoomFunctionNames.nDMXComponentFunctions = { "Zoom" };
+
+	SpotSearchNames = { "spot" };
+	BeamSearchNames = { "beam" };
+	LensSearchNames = { "lens" };
+	YokeSearchNames = { "yoke" };
+	HeadSearchNames = { "head" };
+	SpringArmSearchNames = { "spring" };
+}
+
+const ULexyVFXDMXFixtureType* ULexyVFXDMXFixtureType::GetDefaultType()
+{
+	return GetDefault<ULexyVFXDMXFixtureType>();
+}
+
+// Large enough that an unlimited axis lands on its target in a single step
+static const float fUnlimitedMotion = 1e20f;
+
+FVector4 ULexyVFXDMXFixtureType::GetMotionMaxSpeeds() const
+{
+	return FVector4(
+		fPanMaxSpeed > 0.0f ? fPanMaxSpeed : fUnlimitedMotion,
+		fTiltMaxSpeed > 0.0f ? fTiltMaxSpeed : fUnlimitedMotion,
+		fZoomMaxSpeed > 0.0f ? fZoomMaxSpeed : fUnlimitedMotion,
+		0.0f);
+}
+
+FVector4 ULexyVFXDMXFixtureType::GetMotionMaxAccelerations() const
+{
+	return FVector4(
+		fPanMaxSpeed > 0.0f && fPanMaxAcceleration > 0.0f ? fPanMaxAcceleration : fUnlimitedMotion,
+		fTiltMaxSpeed > 0.0f && fTiltMaxAcceleration > 0.0f ? fTiltMaxAcceleration : fUnlimitedMotion,
+		fZoomMaxSpeed > 0.0f && fZoomMaxAcceleration > 0.0f ? fZoomMaxAcceleration : fUnlimitedMotion,
+		0.0f);
+}
+
+SIZE_T ULexyVFXDMXFixtureType::GetSharedConfigBytes() const
+{
+	SIZE_T outBytes = 0;
+	for (TFieldIterator<FProperty> It(GetClass(), EFieldIteratorFlags::ExcludeSuper); It; ++It)
+	{
+		outBytes += LexyVFXDMXFixtureTypeMemory::GetPropertyBytes(*It, It->ContainerPtrToValuePtr<void>(this));
+	}
+	return outBytes;
+}
@@ -2,6 +2,9 @@
 
 
 #include "LexyVFXDMXFunctionManager.h"
+#include "LexyVFXDMXFixtureType.h"
+#include "LexyVFXDMXFixtureSubsystem.h"
+#include "DMXRuntime/Public/Library/DMXEntityFixtureType.h"
 
 // Sets default values for this component's properties
 ULexyVFXDMXFunctionManager::ULexyVFXDMXFunctionManager()
@@ -18,15 +21,36 @@ ULexyVFXDMXFunctionManager::ULexyVFXDMXFunctionManager()
 void ULexyVFXDMXFunctionManager::BeginPlay()
 {
 	Super::BeginPlay();
+
+	ULexyVFXDMXFixtureSubsystem *FixtureSubsystem = ULexyVFXDMXFixtureSubsystem::Get(this);
+	if (!FixtureSubsystem || !FixtureSubsystem->DeferInitialization(this->GetOwner()))
+		InitializeFixture();
+}
+
+void ULexyVFXDMXFunctionManager::InitializeFixture()
+{
+	bFixtureInitialized = true;
 	this->SetParentDMXRef();
 	SetFunctionComponentReferences();
-	static UDMXSubsystem* UnrealDMXSubsystem = UDMXSubsystem::GetDMXSubsystem_Pure();
-	ReceivedDMX.BindUFunction(this, "ProcessDMX");
 
-	// Using OnProtocolReceived_Deprecated until the DMXComponent's OnPatchReceived is made Public in 4.26.1
-	UnrealDMXSubsystem->OnProtocolReceived_DEPRECATED.Add(ULexyVFXDMXFunctionManager::ReceivedDMX);
-	// ...
-	
+	// DMX is received once by the fixture subsystem and dispatched to the fixtures patched on each universe
+	if (ULexyVFXDMXFixtureSubsystem *FixtureSubsystem = ULexyVFXDMXFixtureSubsystem::Get(this))
+		FixtureSubsystem->RegisterFixture(this);
+}
+
+void ULexyVFXDMXFunctionManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (ULexyVFXDMXFixtureSubsystem *FixtureSubsystem = ULexyVFXDMXFixtureSubsystem::Get(this))
+	{
+		// Streaming the level out keeps the fixture's look for when it streams back in
+		if (EndPlayReason == EEndPlayReason::RemovedFromWorld && bFixtureInitialized)
+			FixtureSubsystem->UnloadFixture(this);
+		else
+			FixtureSubsystem->UnregisterFixture(this);
+	}
+	bFixtureInitialized = false;
+
+	Super::EndPlay(EndPlayReason);
 }
 
 
@@ -41,11 +65,93 @@ void ULexyVFXDMXFunctionManager::TickComponent(float DeltaTime, ELevelTick TickT
 void ULexyVFXDMXFunctionManager::SetParentDMXRef()
 {
 	DMXComp = Cast<UDMXComponent>(this->GetOwner()->GetComponentByClass(UDMXComponent::StaticClass()));
+	RefreshPatch();
+}
 
-	if (DMXComp->IsValidLowLevel())
-		Patch = DMXComp->GetFixturePatch();
+void ULexyVFXDMXFunctionManager::RefreshPatch()
+{
+	Patch = DMXComp->IsValidLowLevel() ? DMXComp->GetFixturePatch() : nullptr;
 	if (!Patch)
 		UE_LOG(LogTemp, Warning, TEXT("Couldn't find valid DMX Patch on DMX Component"));
+
+	for (ULexyVFXDMXBaseComponent* functionComponent : LexyVFXFunctionComponents)
+	{
+		functionComponent->DMXComp = DMXComp;
+		functionComponent->Patch = Patch;
+	}
+}
+
+void ULexyVFXDMXFunctionManager::BuildChannelOffsets()
+{
+	ChannelOffsets.Reset();
+	BoundUniverse = INDEX_NONE;
+	BindingSignature = GetBindingSignature();
+
+	const UDMXEntityFixtureType *PatchType = Patch ? Patch->ParentFixtureTypeTemplate : nullptr;
+	if (!PatchType || !PatchType->Modes.IsValidIndex(Patch->ActiveMode))
+	{
+		BindFunctionChannels();
+		return;
+	}
+
+	BoundUniverse = Patch->GetRemoteUniverse();
+	const int32 startingOffset = Patch->GetStartingChannel() - 1;
+
+	for (const FDMXFixtureFunction& Function : PatchType->Modes[Patch->ActiveMode].Functions)
+	{
+		FLexyVFXDMXChannelOffset ChannelOffset;
+		ChannelOffset.Attribute = Function.Attribute;
+		ChannelOffset.Offset = startingOffset + Function.Channel - 1;
+		ChannelOffset.bLSBMode = Function.bUseLSBMode;
+
+		switch (Function.DataType)
+		{
+		case EDMXFixtureSignalFormat::E16Bit:
+			ChannelOffset.NumBytes = 2;
+			break;
+		case EDMXFixtureSignalFormat::E24Bit:
+			ChannelOffset.NumBytes = 3;
+			break;
+		case EDMXFixtureSignalFormat::E32Bit:
+			ChannelOffset.NumBytes = 4;
+			break;
+		default:
+			ChannelOffset.NumBytes = 1;
+			break;
+		}
+
+		if (ChannelOffset.Offset >= 0 && ChannelOffset.Offset + ChannelOffset.NumBytes <= 512)
+			ChannelOffsets.Add(ChannelOffset);
+	}
+
+	BindFunctionChannels();
+}
+
+void ULexyVFXDMXFunctionManager::BindFunctionChannels()
+{
+	ChannelValues.Init(0, ChannelOffsets.Num() + 1);
+	for (ULexyVFXDMXBaseComponent* functionComponent : LexyVFXFunctionComponents)
+	{
+		functionComponent->BindChannels(ChannelOffsets);
+	}
+}
+
+uint32 ULexyVFXDMXFunctionManager::GetBindingSignature() const
+{
+	if (!Patch)
+		return 0;
+
+	uint32 outSignature = GetTypeHash(Patch);
+	outSignature = HashCombine(outSignature, GetTypeHash(Patch->ParentFixtureTypeTemplate));
+	outSignature = HashCombine(outSignature, GetTypeHash(Patch->GetRemoteUniverse()));
+	outSignature = HashCombine(outSignature, GetTypeHash(Patch->GetStartingChannel()));
+	outSignature = HashCombine(outSignature, GetTypeHash(Patch->ActiveMode));
+	return outSignature;
+}
+
+const ULexyVFXDMXFixtureType* ULexyVFXDMXFunctionManager::GetFixtureType() const
+{
+	return FixtureType ? FixtureType : ULexyVFXDMXFixtureType::GetDefaultType();
 }
 
 void ULexyVFXDMXFunctionManager::SetFunctionComponentReferences()
@@ -56,21 +162,74 @@ void ULexyVFXDMXFunctionManager::SetFunctionComponentReferences()
 	{
 		ULexyVFXDMXBaseComponent* localcomp = Cast<ULexyVFXDMXBaseComponent>(actorcomponent);
 		if (localcomp->IsValidLowLevel())
-			LexyVFXFunctionComponents.AddUnique(localcomp);
+			AddFunctionComponent(localcomp);
 	}
 }
 
-void ULexyVFXDMXFunctionManager::ProcessDMX(FDMXProtocolName Protocol, int32 Universe, const TArray<uint8>& DMXBuffer)
+void ULexyVFXDMXFunctionManager::AddFunctionComponent(ULexyVFXDMXBaseComponent *FunctionComponent)
 {
-	TMap<FName, int32> NImapDMXFunctionValues;
-	TMap<FDMXAttributeName, int32> DImapDMXFunctionValues;
-	TArray<FName> LocalKeys;
-	static UDMXSubsystem* UnrealDMXSubsystem = UDMXSubsystem::GetDMXSubsystem_Pure();
-	UnrealDMXSubsystem->GetFunctionsMap(Patch, DImapDMXFunctionValues);
-	NImapDMXFunctionValues.GetKeys(LocalKeys);
+	LexyVFXFunctionComponents.AddUnique(FunctionComponent);
+	FunctionComponent->DMXComp = DMXComp;
+	FunctionComponent->Patch = Patch;
+	FunctionComponent->BindChannels(ChannelOffsets);
+}
+
+void ULexyVFXDMXFunctionManager::RemoveFunctionComponent(ULexyVFXDMXBaseComponent *FunctionComponent)
+{
+	LexyVFXFunctionComponents.Remove(FunctionComponent);
+}
+
+void ULexyVFXDMXFunctionManager::DecodeDMX(const TMap<FDMXAttributeName, int32>& DImapDMXFunctionValues, FLexyVFXDMXFixtureOutput& OutOutput) const
+{
+	for (const ULexyVFXDMXBaseComponent* functionComponent : LexyVFXFunctionComponents)
+	{
+		functionComponent->DecodeDMX(DImapDMXFunctionValues, OutOutput);
+	}
+}
 
+void ULexyVFXDMXFunctionManager::ApplyOutput(const FLexyVFXDMXFixtureOutput& InOutput)
+{
+	Output = InOutput;
 	for (ULexyVFXDMXBaseComponent* functionComponent : LexyVFXFunctionComponents)
 	{
-		functionComponent->UpdateDMX(DImapDMXFunctionValues, LocalKeys);
+		functionComponent->ApplyOutput(Output);
+	}
+}
+
+void ULexyVFXDMXFunctionManager::ProcessDMX(FDMXProtocolName Protocol, int32 Universe, const TArray<uint8>& DMXBuffer)
+{
+	if (Universe == BoundUniverse)
+		EvaluateDMX(DMXBuffer);
+}
+
+void ULexyVFXDMXFunctionManager::EvaluateDMX(const TArray<uint8>& DMXBuffer)
+{
+	DecodeUniverse(DMXBuffer);
+	ApplyOutput(DecodedOutput);
+}
+
+void ULexyVFXDMXFunctionManager::DecodeUniverse(const TArray<uint8>& DMXBuffer)
+{
+	if (ChannelValues.Num() != ChannelOffsets.Num() + 1)
+		BindFunctionChannels();
+
+	for (int32 i = 0; i != ChannelOffsets.Num(); i++)
+	{
+		const FLexyVFXDMXChannelOffset& ChannelOffset = ChannelOffsets[i];
+		uint32 value = 0;
+		if (ChannelOffset.Offset + ChannelOffset.NumBytes <= DMXBuffer.Num())
+		{
+			for (int32 b = 0; b != ChannelOffset.NumBytes; b++)
+			{
+				const int32 byteIndex = ChannelOffset.bLSBMode ? ChannelOffset.NumBytes - 1 - b : b;
+				value = (value << 8) | DMXBuffer[ChannelOffset.Offset + byteIndex];
+			}
+		}
+		ChannelValues[i] = (int32)value;
+	}
+
+	for (const ULexyVFXDMXBaseComponent* functionComponent : LexyVFXFunctionComponents)
+	{
+		functionComponent->DecodeChannels(ChannelValues.GetData(), DecodedOutput);
 	}
 }
\ No newline at end of file
@@ -0,0 +1,164 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "LexyVFXDMXJitterBuffer.h"
+
+namespace LexyVFXDMXJitterBuffer
+{
+	// Smoothing of the interval and jitter estimates, as in RFC 3550
+	static const double fTimingGain = 1.0 / 16.0;
+
+	// A clock moving back further than this is a timecode jump, held frames are released rather than held for the jump
+	static const double fClockJumpSeconds = 1.0;
+}
+
+void FLexyVFXDMXJitterBuffer::Push(int32 Universe, const TArray<uint8>& DMXBuffer, double Timestamp)
+{
+	FUniverseFrames& UniverseFrames = Frames.FindOrAdd(Universe);
+	const int32 maxFrames = FMath::Max(MaxFramesPerUniverse, 1);
+
+	while (UniverseFrames.Num >= maxFrames)
+	{
+		// The oldest frame's slot takes the new one
+		UniverseFrames.Head = (UniverseFrames.Head + 1) % UniverseFrames.Ring.Num();
+		UniverseFrames.Num--;
+		NumFrames--;
+		FramesDropped++;
+
+		if (!UniverseFrames.bDropWarned)
+			UE_LOG(LogTemp, Warning, TEXT("DMX jitter buffer full on universe %d, dropping frames. Raise LexyVFX.DMX.JitterBuffer.MaxFramesPerUniverse above %d or lower the delay"), Universe, maxFrames);
+		UniverseFrames.bDropWarned = true;
+	}
+
+	if (UniverseFrames.Num == UniverseFrames.Ring.Num())
+	{
+		// Grows by unrolling the ring so the oldest frame is first again
+		TArray<FFrame> Ring;
+		Ring.Reserve(FMath::Min(FMath::Max(UniverseFrames.Num * 2, 16), maxFrames));
+		for (int32 i = 0; i != UniverseFrames.Num; i++)
+		{
+			Ring.Add(MoveTemp(UniverseFrames.Ring[(UniverseFrames.Head + i) % UniverseFrames.Ring.Num()]));
+		}
+		Ring.SetNum(Ring.Max());
+		UniverseFrames.Ring = MoveTemp(Ring);
+		UniverseFrames.Head = 0;
+	}
+
+	FFrame& Frame = UniverseFrames.Ring[(UniverseFrames.Head + UniverseFrames.Num) % UniverseFrames.Ring.Num()];
+	Frame.Timestamp = Timestamp;
+	Frame.Buffer = DMXBuffer;
+	UniverseFrames.Num++;
+	NumFrames++;
+
+	MaxBufferDepth = FMath::Max(MaxBufferDepth, NumFrames);
+}
+
+void FLexyVFXDMXJitterBuffer::RecordArrival(FName Source, int32 Universe, double ArrivalSeconds)
+{
+	using namespace LexyVFXDMXJitterBuffer;
+
+	FUniverseTiming& Timing = UniverseTimings.FindOrAdd(TPair<FName, int32>(Source, Universe));
+	if (Timing.NumArrivals > 0)
+	{
+		const double interval = ArrivalSeconds - Timing.LastArrival;
+		if (Timing.NumArrivals == 1)
+			Timing.Interval = interval;
+
+		const double deviation = FMath::Abs(interval - Timing.Interval);
+		Timing.Interval += (interval - Timing.Interval) * fTimingGain;
+		Timing.Jitter += (deviation - Timing.Jitter) * fTimingGain;
+		Timing.MaxJitter = FMath::Max(Timing.MaxJitter, deviation);
+	}
+	Timing.LastArrival = ArrivalSeconds;
+	Timing.NumArrivals++;
+}
+
+void FLexyVFXDMXJitterBuffer::Release(double ReleaseTime, TFunctionRef<void(int32 Universe, const TArray<uint8>& DMXBuffer)> ApplyUniverse)
+{
+	using namespace LexyVFXDMXJitterBuffer;
+
+	if (ReleaseTime < LastReleaseTime - fClockJumpSeconds)
+	{
+		Flush(ApplyUniverse);
+		LastReleaseTime = ReleaseTime;
+		return;
+	}
+	LastReleaseTime = ReleaseTime;
+
+	if (NumFrames == 0)
+		return;
+
+	for (TPair<int32, FUniverseFrames>& UniverseFrames : Frames)
+	{
+		ReleaseFrames(UniverseFrames.Key, UniverseFrames.Value, ReleaseTime, ApplyUniverse);
+	}
+}
+
+void FLexyVFXDMXJitterBuffer::Flush(TFunctionRef<void(int32 Universe, const TArray<uint8>& DMXBuffer)> ApplyUniverse)
+{
+	if (NumFrames == 0)
+		return;
+
+	for (TPair<int32, FUniverseFrames>& UniverseFrames : Frames)
+	{
+		ReleaseFrames(UniverseFrames.Key, UniverseFrames.Value, TNumericLimits<double>::Max(), ApplyUniverse);
+	}
+}
+
+void FLexyVFXDMXJitterBuffer::ReleaseFrames(int32 Universe, FUniverseFrames& UniverseFrames, double ReleaseTime, TFunctionRef<void(int32 Universe, const TArray<uint8>& DMXBuffer)> ApplyUniverse)
+{
+	while (UniverseFrames.Num > 0)
+	{
+		const FFrame& Frame = UniverseFrames.Ring[UniverseFrames.Head];
+		if (Frame.Timestamp > ReleaseTime)
+			break;
+
+		ApplyUniverse(Universe, Frame.Buffer);
+		UniverseFrames.Head = (UniverseFrames.Head + 1) % UniverseFrames.Ring.Num();
+		UniverseFrames.Num--;
+		NumFrames--;
+		FramesReleased++;
+	}
+}
+
+FLexyVFXDMXJitterStats FLexyVFXDMXJitterBuffer::GetStats(float DelayMs) const
+{
+	FLexyVFXDMXJitterStats outStats;
+	outStats.DelayMs = DelayMs;
+	outStats.BufferDepth = NumFrames;
+	outStats.MaxBufferDepth = MaxBufferDepth;
+	outStats.FramesReleased = FramesReleased;
+	outStats.FramesDropped = FramesDropped;
+
+	int32 numUniverses = 0;
+	for (const TPair<TPair<FName, int32>, FUniverseTiming>& UniverseTiming : UniverseTimings)
+	{
+		const FUniverseTiming& Timing = UniverseTiming.Value;
+		if (Timing.NumArrivals < 2)
+			continue;
+
+		outStats.IntervalMs += Timing.Interval * 1000.0;
+		outStats.JitterMs += Timing.Jitter * 1000.0;
+		outStats.MaxJitterMs = FMath::Max(outStats.MaxJitterMs, float(Timing.MaxJitter * 1000.0));
+		numUniverses++;
+	}
+
+	if (numUniverses > 0)
+	{
+		outStats.IntervalMs /= numUniverses;
+		outStats.JitterMs /= numUniverses;
+	}
+	return outStats;
+}
+
+void FLexyVFXDMXJitterBuffer::ResetStats()
+{
+	UniverseTimings.Reset();
+	MaxBufferDepth = NumFrames;
+	for (TPair<int32, FUniverseFrames>& UniverseFrames : Frames)
+	{
+		UniverseFrames.Value.bDropWarned = false;
+	}
+	FramesReleased = 0;
+	FramesDropped = 0;
+}
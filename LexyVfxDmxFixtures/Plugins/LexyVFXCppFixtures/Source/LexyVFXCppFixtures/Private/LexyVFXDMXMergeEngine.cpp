@@ -0,0 +1,213 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "LexyVFXDMXMergeEngine.h"
+
+#if PLATFORM_CPU_X86_FAMILY
+#include <emmintrin.h>
+#elif PLATFORM_CPU_ARM_FAMILY && PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+#include <arm_neon.h>
+#endif
+
+void FLexyVFXDMXMergeEngine::MaxBytes(uint8 *Dest, const uint8 *Source, int32 Num)
+{
+	int32 i = 0;
+#if PLATFORM_CPU_X86_FAMILY
+	for (; i + 16 <= Num; i += 16)
+	{
+		const __m128i destBytes = _mm_loadu_si128((const __m128i*)(Dest + i));
+		const __m128i sourceBytes = _mm_loadu_si128((const __m128i*)(Source + i));
+		_mm_storeu_si128((__m128i*)(Dest + i), _mm_max_epu8(destBytes, sourceBytes));
+	}
+#elif PLATFORM_CPU_ARM_FAMILY && PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+	for (; i + 16 <= Num; i += 16)
+	{
+		vst1q_u8(Dest + i, vmaxq_u8(vld1q_u8(Dest + i), vld1q_u8(Source + i)));
+	}
+#endif
+	for (; i < Num; i++)
+	{
+		Dest[i] = FMath::Max(Dest[i], Source[i]);
+	}
+}
+
+int32 FLexyVFXDMXMergeEngine::FindOrAddSource(FName Source)
+{
+	if (const int32* SourceIndex = SourceIndices.Find(Source))
+		return *SourceIndex;
+
+	const int32 sourceIndex = SourceNames.Add(Source);
+	SourcePriorities.Add(DefaultPriority);
+	SourceIndices.Add(Source, sourceIndex);
+	return sourceIndex;
+}
+
+void FLexyVFXDMXMergeEngine::SetSourcePriority(FName Source, int32 Priority)
+{
+	const int32 sourceIndex = FindOrAddSource(Source);
+	if (SourcePriorities[sourceIndex] == Priority)
+		return;
+
+	SourcePriorities[sourceIndex] = Priority;
+	for (TPair<int32, FUniverse>& Universe : Universes)
+	{
+		for (const FUniverseSource& UniverseSource : Universe.Value.Sources)
+		{
+			if (UniverseSource.SourceIndex == sourceIndex)
+				DirtyUniverses.Add(Universe.Key);
+		}
+	}
+}
+
+void FLexyVFXDMXMergeEngine::SetUniverseMergeMode(int32 Universe, ELexyVFXDMXMergeMode Mode)
+{
+	Universes.FindOrAdd(Universe).Mode = Mode;
+	DirtyUniverses.Add(Universe);
+}
+
+const TArray<uint8>* FLexyVFXDMXMergeEngine::Receive(FName Source, int32 Universe, TArrayView<const uint8> DMXBuffer, double Now)
+{
+	const int32 sourceIndex = FindOrAddSource(Source);
+	FUniverse& MergeUniverse = Universes.FindOrAdd(Universe);
+	FrameStamp++;
+
+	FUniverseSource *UniverseSource = MergeUniverse.Sources.FindByPredicate([sourceIndex](const FUniverseSource& Candidate) { return Candidate.SourceIndex == sourceIndex; });
+	if (!UniverseSource)
+	{
+		// A source joining a universe owns all of its channels for LTP
+		UniverseSource = &MergeUniverse.Sources.AddDefaulted_GetRef();
+		UniverseSource->SourceIndex = sourceIndex;
+		UniverseSource->Buffer.SetNumZeroed(UniverseSize);
+		UniverseSource->ChannelStamps.Init(FrameStamp, UniverseSize);
+	}
+	UniverseSource->LastReceived = Now;
+
+	const int32 numChannels = FMath::Min(DMXBuffer.Num(), UniverseSize);
+	uint8 *SourceBytes = UniverseSource->Buffer.GetData();
+	uint32 *ChannelStamps = UniverseSource->ChannelStamps.GetData();
+	for (int32 channel = 0; channel != numChannels; channel++)
+	{
+		if (SourceBytes[channel] != DMXBuffer[channel])
+		{
+			SourceBytes[channel] = DMXBuffer[channel];
+			ChannelStamps[channel] = FrameStamp;
+		}
+	}
+
+	DirtyUniverses.Remove(Universe);
+	return Merge(MergeUniverse) ? &MergeUniverse.Merged : nullptr;
+}
+
+void FLexyVFXDMXMergeEngine::Update(double Now, TFunctionRef<void(int32 Universe, const TArray<uint8>& DMXBuffer)> ApplyUniverse)
+{
+	for (TPair<int32, FUniverse>& Universe : Universes)
+	{
+		const int32 numRemoved = Universe.Value.Sources.RemoveAllSwap([this, Now](const FUniverseSource& UniverseSource)
+		{
+			return UniverseSource.LastReceived < Now - SourceTimeout;
+		});
+
+		if (numRemoved > 0)
+			DirtyUniverses.Add(Universe.Key);
+	}
+
+	for (int32 universe : DirtyUniverses)
+	{
+		FUniverse& MergeUniverse = Universes.FindOrAdd(universe);
+		if (Merge(MergeUniverse))
+			ApplyUniverse(universe, MergeUniverse.Merged);
+	}
+	DirtyUniverses.Reset();
+}
+
+bool FLexyVFXDMXMergeEngine::Merge(FUniverse& Universe)
+{
+	// With every source gone the last merged state is held
+	if (Universe.Sources.Num() == 0)
+		return false;
+
+	int32 topPriority = MIN_int32;
+	int32 numTopSources = 0;
+	const FUniverseSource *TopSource = nullptr;
+	for (const FUniverseSource& UniverseSource : Universe.Sources)
+	{
+		const int32 priority = SourcePriorities[UniverseSource.SourceIndex];
+		if (priority > topPriority)
+		{
+			topPriority = priority;
+			numTopSources = 0;
+		}
+		if (priority == topPriority)
+		{
+			TopSource = &UniverseSource;
+			numTopSources++;
+		}
+	}
+
+	MergeScratch.SetNumUninitialized(UniverseSize, false);
+	uint8 *MergedBytes = MergeScratch.GetData();
+
+	if (numTopSources == 1)
+	{
+		FMemory::Memcpy(MergedBytes, TopSource->Buffer.GetData(), UniverseSize);
+	}
+	else if (Universe.Mode.Get(DefaultMode) == ELexyVFXDMXMergeMode::MergeMode_HTP)
+	{
+		FMemory::Memzero(MergedBytes, UniverseSize);
+		for (const FUniverseSource& UniverseSource : Universe.Sources)
+		{
+			if (SourcePriorities[UniverseSource.SourceIndex] == topPriority)
+				MaxBytes(MergedBytes, UniverseSource.Buffer.GetData(), UniverseSize);
+		}
+	}
+	else
+	{
+		uint32 NewestStamps[UniverseSize] = {};
+		for (const FUniverseSource& UniverseSource : Universe.Sources)
+		{
+			if (SourcePriorities[UniverseSource.SourceIndex] != topPriority)
+				continue;
+
+			const uint8 *SourceBytes = UniverseSource.Buffer.GetData();
+			const uint32 *ChannelStamps = UniverseSource.ChannelStamps.GetData();
+			for (int32 channel = 0; channel != UniverseSize; channel++)
+			{
+				if (ChannelStamps[channel] >= NewestStamps[channel])
+				{
+					NewestStamps[channel] = ChannelStamps[channel];
+					MergedBytes[channel] = SourceBytes[channel];
+				}
+			}
+		}
+	}
+
+	if (Universe.Merged.Num() == UniverseSize && FMemory::Memcmp(Universe.Merged.GetData(), MergedBytes, UniverseSize) == 0)
+		return false;
+
+	Swap(Universe.Merged, MergeScratch);
+	return true;
+}
+
+void FLexyVFXDMXMergeEngine::LogSources() const
+{
+	static const TCHAR* ModeNames[] = { TEXT("HTP"), TEXT("LTP") };
+
+	UE_LOG(LogTemp, Warning, TEXT("LexyVFX DMX merge: %d sources, %d universes, default %s"), SourceNames.Num(), Universes.Num(), ModeNames[(uint8)DefaultMode]);
+	for (int32 sourceIndex = 0; sourceIndex != SourceNames.Num(); sourceIndex++)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("  source %s, priority %d"), *SourceNames[sourceIndex].ToString(), SourcePriorities[sourceIndex]);
+	}
+
+	for (const TPair<int32, FUniverse>& Universe : Universes)
+	{
+		if (Universe.Value.Sources.Num() < 2)
+			continue;
+
+		FString Sources;
+		for (const FUniverseSource& UniverseSource : Universe.Value.Sources)
+		{
+			Sources += FString::Printf(TEXT(" %s"), *SourceNames[UniverseSource.SourceIndex].ToString());
+		}
+		UE_LOG(LogTemp, Warning, TEXT("  universe %d %s:%s"), Universe.Key, ModeNames[(uint8)Universe.Value.Mode.Get(DefaultMode)], *Sources);
+	}
+}
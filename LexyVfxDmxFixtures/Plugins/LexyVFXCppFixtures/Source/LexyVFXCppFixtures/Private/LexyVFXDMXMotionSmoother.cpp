@@ -0,0 +1,82 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "LexyVFXDMXMotionSmoother.h"
+#include "Math/VectorRegister.h"
+
+int32 FLexyVFXDMXMotionSmoother::AddSlot(const FVector4& Position)
+{
+	Velocities.Add(FVector4(0.0f, 0.0f, 0.0f, 0.0f));
+	Targets.Add(Position);
+	MaxSpeeds.Add(FVector4(0.0f, 0.0f, 0.0f, 0.0f));
+	MaxAccelerations.Add(FVector4(0.0f, 0.0f, 0.0f, 0.0f));
+	return Positions.Add(Position);
+}
+
+void FLexyVFXDMXMotionSmoother::RemoveSlot(int32 Slot)
+{
+	Positions.RemoveAtSwap(Slot, 1, false);
+	Velocities.RemoveAtSwap(Slot, 1, false);
+	Targets.RemoveAtSwap(Slot, 1, false);
+	MaxSpeeds.RemoveAtSwap(Slot, 1, false);
+	MaxAccelerations.RemoveAtSwap(Slot, 1, false);
+}
+
+void FLexyVFXDMXMotionSmoother::Reset()
+{
+	Positions.Reset();
+	Velocities.Reset();
+	Targets.Reset();
+	MaxSpeeds.Reset();
+	MaxAccelerations.Reset();
+}
+
+void FLexyVFXDMXMotionSmoother::SetTarget(int32 Slot, const FVector4& Target, const FVector4& MaxSpeed, const FVector4& MaxAcceleration)
+{
+	Targets[Slot] = Target;
+	MaxSpeeds[Slot] = MaxSpeed;
+	MaxAccelerations[Slot] = MaxAcceleration;
+}
+
+bool FLexyVFXDMXMotionSmoother::IsSettled(int32 Slot) const
+{
+	return Positions[Slot] == Targets[Slot] && Velocities[Slot].X == 0.0f && Velocities[Slot].Y == 0.0f && Velocities[Slot].Z == 0.0f;
+}
+
+void FLexyVFXDMXMotionSmoother::Step(float DeltaTime)
+{
+	const VectorRegister Zero = VectorZero();
+	const VectorRegister Two = VectorSetFloat1(2.0f);
+	const VectorRegister Tiny = VectorSetFloat1(SMALL_NUMBER * SMALL_NUMBER);
+	const VectorRegister Dt = VectorSetFloat1(DeltaTime);
+
+	FVector4 *Position = Positions.GetData();
+	FVector4 *Velocity = Velocities.GetData();
+	const FVector4 *Target = Targets.GetData();
+	const FVector4 *MaxSpeed = MaxSpeeds.GetData();
+	const FVector4 *MaxAcceleration = MaxAccelerations.GetData();
+
+	for (int32 i = 0, num = Positions.Num(); i != num; i++)
+	{
+		const VectorRegister P = VectorLoad(&Position[i]);
+		const VectorRegister V = VectorLoad(&Velocity[i]);
+		const VectorRegister T = VectorLoad(&Target[i]);
+		const VectorRegister A = VectorLoad(&MaxAcceleration[i]);
+
+		// Fastest speed the axis can still stop from within the remaining distance, sqrt(2 * A * |Err|)
+		const VectorRegister Err = VectorSubtract(T, P);
+		const VectorRegister StopSpeedSq = VectorMax(VectorMultiply(VectorMultiply(Two, A), VectorAbs(Err)), Tiny);
+		const VectorRegister StopSpeed = VectorMultiply(StopSpeedSq, VectorReciprocalSqrt(StopSpeedSq));
+		const VectorRegister DesiredV = VectorMultiply(VectorSign(Err), VectorMin(VectorLoad(&MaxSpeed[i]), StopSpeed));
+
+		const VectorRegister MaxDv = VectorMultiply(A, Dt);
+		const VectorRegister Dv = VectorMax(VectorNegate(MaxDv), VectorMin(VectorSubtract(DesiredV, V), MaxDv));
+		const VectorRegister NewV = VectorAdd(V, Dv);
+		const VectorRegister Move = VectorMultiply(NewV, Dt);
+
+		// Lands on the target instead of overshooting it, the same test stops an axis already on its target
+		const VectorRegister Land = VectorCompareGE(VectorMultiply(Move, Err), VectorMultiply(Err, Err));
+		VectorStore(VectorSelect(Land, T, VectorAdd(P, Move)), &Position[i]);
+		VectorStore(VectorSelect(Land, Zero, NewV), &Velocity[i]);
+	}
+}
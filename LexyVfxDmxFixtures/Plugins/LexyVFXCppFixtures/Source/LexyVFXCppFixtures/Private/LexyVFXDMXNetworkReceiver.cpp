@@ -0,0 +1,210 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "LexyVFXDMXNetworkReceiver.h"
+#include "Common/UdpSocketBuilder.h"
+#include "Interfaces/IPv4/IPv4Address.h"
+#include "Interfaces/IPv4/IPv4Endpoint.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+
+namespace LexyVFXDMXNetworkReceiver
+{
+	static const int32 UniverseSize = 512;
+
+	// ArtDmx: "Art-Net", OpCode 0x5000 little endian, protocol version, sequence, physical, port address, length
+	static const uint8 ArtNetId[8] = { 'A', 'r', 't', '-', 'N', 'e', 't', 0 };
+	static const uint16 OpDmx = 0x5000;
+	static const int32 ArtDmxHeaderSize = 18;
+
+	// E1.31 data packet: root layer with the CID, framing layer with priority, options and universe, DMP layer
+	static const uint8 ACNPacketId[12] = { 'A', 'S', 'C', '-', 'E', '1', '.', '1', '7', 0, 0, 0 };
+	static const uint32 VectorRootE131Data = 0x00000004;
+	static const uint32 VectorE131DataPacket = 0x00000002;
+	static const uint8 VectorDMPSetProperty = 0x02;
+	static const uint8 OptionPreviewData = 0x80;
+	static const uint8 OptionStreamTerminated = 0x40;
+	static const int32 SACNHeaderSize = 126;
+
+	static uint16 ReadBigEndian16(const uint8 *Data)
+	{
+		return uint16(Data[0] << 8 | Data[1]);
+	}
+
+	static uint32 ReadBigEndian32(const uint8 *Data)
+	{
+		return uint32(Data[0]) << 24 | uint32(Data[1]) << 16 | uint32(Data[2]) << 8 | uint32(Data[3]);
+	}
+
+	static FSocket* OpenSocket(const TCHAR *Description, int32 Port)
+	{
+		return FUdpSocketBuilder(Description)
+			.AsNonBlocking()
+			.AsReusable()
+			.BoundToPort(Port)
+			.WithMulticastLoopback()
+			.WithReceiveBufferSize(4 * 1024 * 1024)
+			.Build();
+	}
+
+	static void DestroySocket(FSocket *&Socket)
+	{
+		if (!Socket)
+			return;
+
+		Socket->Close();
+		ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Socket);
+		Socket = nullptr;
+	}
+}
+
+FLexyVFXDMXNetworkReceiver::~FLexyVFXDMXNetworkReceiver()
+{
+	Close();
+}
+
+bool FLexyVFXDMXNetworkReceiver::Open()
+{
+	using namespace LexyVFXDMXNetworkReceiver;
+
+	Close();
+	ArtNetSocket = OpenSocket(TEXT("LexyVFXDMXArtNet"), ArtNetPort);
+	SACNSocket = OpenSocket(TEXT("LexyVFXDMXsACN"), SACNPort);
+	if (!ArtNetSocket)
+		UE_LOG(LogTemp, Warning, TEXT("Couldn't open the Art-Net port %d"), ArtNetPort);
+	if (!SACNSocket)
+		UE_LOG(LogTemp, Warning, TEXT("Couldn't open the sACN port %d"), SACNPort);
+
+	PacketsRead = 0;
+	PacketsIgnored = 0;
+	return IsOpen();
+}
+
+void FLexyVFXDMXNetworkReceiver::Close()
+{
+	LexyVFXDMXNetworkReceiver::DestroySocket(ArtNetSocket);
+	LexyVFXDMXNetworkReceiver::DestroySocket(SACNSocket);
+	JoinedUniverses.Reset();
+}
+
+void FLexyVFXDMXNetworkReceiver::JoinSACNUniverse(int32 Universe)
+{
+	// sACN universes are 1-63999
+	if (!SACNSocket || Universe < 1 || Universe > 63999 || JoinedUniverses.Contains(Universe))
+		return;
+
+	JoinedUniverses.Add(Universe);
+	const FIPv4Address GroupIp(239, 255, uint8(Universe >> 8), uint8(Universe & 0xFF));
+	if (!SACNSocket->JoinMulticastGroup(*FIPv4Endpoint(GroupIp, SACNPort).ToInternetAddr()))
+		UE_LOG(LogTemp, Warning, TEXT("Couldn't join the sACN multicast group of universe %d"), Universe);
+}
+
+int32 FLexyVFXDMXNetworkReceiver::Poll(TFunctionRef<void(FName Source, int32 Priority, int32 Universe, TArrayView<const uint8> DMXBuffer)> ReadPacket)
+{
+	return PollSocket(ArtNetSocket, false, ReadPacket) + PollSocket(SACNSocket, true, ReadPacket);
+}
+
+int32 FLexyVFXDMXNetworkReceiver::PollSocket(FSocket *Socket, bool bSACN, TFunctionRef<void(FName Source, int32 Priority, int32 Universe, TArrayView<const uint8> DMXBuffer)> ReadPacket)
+{
+	if (!Socket)
+		return 0;
+
+	TSharedRef<FInternetAddr> Sender = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->CreateInternetAddr();
+	int32 numRead = 0;
+	uint32 pendingSize = 0;
+
+	while (Socket->HasPendingData(pendingSize))
+	{
+		ReceivedData.SetNumUninitialized(FMath::Min(pendingSize, 65507u), false);
+		int32 bytesRead = 0;
+		if (!Socket->RecvFrom(ReceivedData.GetData(), ReceivedData.Num(), bytesRead, *Sender))
+			break;
+		const TArrayView<const uint8> Data(ReceivedData.GetData(), bytesRead);
+
+		int32 universe;
+		TArrayView<const uint8> DMXBuffer;
+		if (bSACN)
+		{
+			FGuid CID;
+			int32 priority;
+			if (!ParseSACN(Data, CID, priority, universe, DMXBuffer))
+			{
+				PacketsIgnored++;
+				continue;
+			}
+
+			FName *Source = SACNSources.Find(CID);
+			if (!Source)
+				Source = &SACNSources.Add(CID, FName(*FString::Printf(TEXT("sACN %s"), *CID.ToString(EGuidFormats::DigitsWithHyphens))));
+			ReadPacket(*Source, priority, universe, DMXBuffer);
+		}
+		else
+		{
+			if (!ParseArtDmx(Data, universe, DMXBuffer))
+			{
+				PacketsIgnored++;
+				continue;
+			}
+
+			uint32 senderIp = 0;
+			Sender->GetIp(senderIp);
+			FName *Source = ArtNetSources.Find(senderIp);
+			if (!Source)
+				Source = &ArtNetSources.Add(senderIp, FName(*FString::Printf(TEXT("Art-Net %s"), *Sender->ToString(false))));
+			ReadPacket(*Source, INDEX_NONE, universe, DMXBuffer);
+		}
+
+		PacketsRead++;
+		numRead++;
+	}
+	return numRead;
+}
+
+bool FLexyVFXDMXNetworkReceiver::ParseArtDmx(TArrayView<const uint8> Data, int32& OutUniverse, TArrayView<const uint8>& OutDMXBuffer)
+{
+	using namespace LexyVFXDMXNetworkReceiver;
+
+	if (Data.Num() < ArtDmxHeaderSize || FMemory::Memcmp(Data.GetData(), ArtNetId, sizeof(ArtNetId)) != 0)
+		return false;
+
+	if (uint16(Data[8] | Data[9] << 8) != OpDmx)
+		return false;
+
+	// 15 bit port address: net, then sub-net and universe
+	OutUniverse = (Data[15] & 0x7F) << 8 | Data[14];
+
+	const int32 length = FMath::Min<int32>(ReadBigEndian16(&Data[16]), UniverseSize);
+	if (length < 1 || Data.Num() < ArtDmxHeaderSize + length)
+		return false;
+
+	OutDMXBuffer = Data.Slice(ArtDmxHeaderSize, length);
+	return true;
+}
+
+bool FLexyVFXDMXNetworkReceiver::ParseSACN(TArrayView<const uint8> Data, FGuid& OutCID, int32& OutPriority, int32& OutUniverse, TArrayView<const uint8>& OutDMXBuffer)
+{
+	using namespace LexyVFXDMXNetworkReceiver;
+
+	if (Data.Num() < SACNHeaderSize || ReadBigEndian16(&Data[0]) != 0x0010 || FMemory::Memcmp(&Data[4], ACNPacketId, sizeof(ACNPacketId)) != 0)
+		return false;
+
+	// Universe discovery and synchronization packets carry no levels
+	if (ReadBigEndian32(&Data[18]) != VectorRootE131Data || ReadBigEndian32(&Data[40]) != VectorE131DataPacket || Data[117] != VectorDMPSetProperty)
+		return false;
+
+	// Preview data is meant for the console's visualizers, a terminating source's last levels are to be ignored and
+	// it drops out of the merge when it times out
+	if (Data[112] & (OptionPreviewData | OptionStreamTerminated))
+		return false;
+
+	// Property values start with the start code, only null start code frames are levels
+	const int32 numValues = ReadBigEndian16(&Data[123]);
+	if (numValues < 2 || Data[125] != 0 || Data.Num() < SACNHeaderSize + numValues - 1)
+		return false;
+
+	OutCID = FGuid(ReadBigEndian32(&Data[22]), ReadBigEndian32(&Data[26]), ReadBigEndian32(&Data[30]), ReadBigEndian32(&Data[34]));
+	OutPriority = Data[108];
+	OutUniverse = ReadBigEndian16(&Data[113]);
+	OutDMXBuffer = Data.Slice(SACNHeaderSize, FMath::Min(numValues - 1, UniverseSize));
+	return true;
+}
@@ -2,17 +2,65 @@
 
 
 #include "LexyVFXDMXPanComponent.h"
+#include "LexyVFXDMXFixtureType.h"
+#include "LexyVFXDMXDecoders.h"
 
-void ULexyVFXDMXPanComponent::BeginPlay()
+namespace LexyVFXDMXPanComponent
 {
-	Super::BeginPlay();
-	this->SetParentDMXRef();
-	this->InitDMXFunctionNames(TArray<FName>({ "Pan" }));
+	template<EDMXParameterBitDepth BitDepth>
+	struct TPanDecoder
+	{
+		static void Decode(const ULexyVFXDMXFixtureType& Type, const int32 *ChannelValues, const int32 *ChannelIndices, FLexyVFXDMXFixtureOutput& Output)
+		{
+			Output.Pan = TLexyVFXDMXDecoder<BitDepth>::MapCentered(ChannelValues[ChannelIndices[0]], Type.fPanRange);
+		}
+	};
 
-	SMRef_Yoke = Cast<UStaticMeshComponent>(this->FindComponentsByName(UStaticMeshComponent::StaticClass(), TArray<FString>({ "yoke" }))[0]);
+	// The yoke turns around its vertical axis
+	static FRotator GetYokeRotation(const FLexyVFXDMXFixtureOutput& Output)
+	{
+		return FRotator(0.0f, Output.Pan, 0.0f);
+	}
 }
 
-void ULexyVFXDMXPanComponent::UpdateDMX(TMap<FDMXAttributeName, int32> DImapDMXFunctionValues, TArray<FName> nDMXComponentFunctions)
+void ULexyVFXDMXPanComponent::BindComponents()
 {
-	this->UpdateDMXRotation(panBitDepth, SMRef_Yoke, EDMXRotationMode::RotationMode_Pan, fPanRange, DImapDMXFunctionValues, this->FunctionNames.nDMXComponentFunctions[0]);
-}
\ No newline at end of file
+	SMRef_Yoke = this->FindFirstComponentByName<UStaticMeshComponent>(this->GetFixtureType()->YokeSearchNames);
+}
+
+FLexyVFXDMXDecodeFunction ULexyVFXDMXPanComponent::SelectDecoder(const ULexyVFXDMXFixtureType& Type) const
+{
+	return LexyVFXDMXDecoders::Select<LexyVFXDMXPanComponent::TPanDecoder>(Type.panBitDepth);
+}
+
+const TArray<FName>& ULexyVFXDMXPanComponent::GetFunctionNames(const ULexyVFXDMXFixtureType& Type) const
+{
+	return Type.PanFunctionNames.nDMXComponentFunctions;
+}
+
+#if WITH_EDITORONLY_DATA
+bool ULexyVFXDMXPanComponent::MigrateDeprecatedConfig(ULexyVFXDMXFixtureType& Type) const
+{
+	if (panBitDepth_DEPRECATED == Type.panBitDepth && fPanRange_DEPRECATED == Type.fPanRange)
+		return false;
+
+	Type.panBitDepth = panBitDepth_DEPRECATED;
+	Type.fPanRange = fPanRange_DEPRECATED;
+	return true;
+}
+#endif
+
+void ULexyVFXDMXPanComponent::ApplyOutput(const FLexyVFXDMXFixtureOutput& Output)
+{
+	using namespace LexyVFXDMXPanComponent;
+
+	if (SMRef_Yoke)
+		SMRef_Yoke->SetRelativeRotation(GetYokeRotation(Output).Quaternion());
+}
+
+void ULexyVFXDMXPanComponent::DescribeBakedTracks(ILexyVFXDMXBakedTracks& Tracks) const
+{
+	using namespace LexyVFXDMXPanComponent;
+
+	Tracks.AddRelativeRotation(SMRef_Yoke, &GetYokeRotation);
+}
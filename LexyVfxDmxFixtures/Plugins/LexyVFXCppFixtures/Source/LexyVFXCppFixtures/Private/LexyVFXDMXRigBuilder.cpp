@@ -0,0 +1,144 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "LexyVFXDMXRigBuilder.h"
+#include "LexyVFXDMXFunctionManager.h"
+#include "LexyVFXDMXFixtureSubsystem.h"
+#include "DMXRuntime/Public/Game/DMXComponent.h"
+#include "DMXRuntime/Public/Library/DMXLibrary.h"
+#include "DMXRuntime/Public/Library/DMXEntityFixturePatch.h"
+#include "DMXRuntime/Public/Library/DMXEntityFixtureType.h"
+#include "Components/SceneComponent.h"
+#include "Engine/World.h"
+#if WITH_EDITOR
+#include "ScopedTransaction.h"
+#endif
+
+ALexyVFXDMXRigBuilder::ALexyVFXDMXRigBuilder()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+}
+
+void ALexyVFXDMXRigBuilder::BuildRig()
+{
+#if WITH_EDITOR
+	// Undoes as one step from the Details panel, the fixtures it spawns and destroys included
+	FScopedTransaction Transaction(NSLOCTEXT("LexyVFXDMXRigBuilder", "BuildRig", "Build DMX Rig"), !GetWorld()->IsGameWorld());
+#endif
+	Modify();
+
+	ClearRig();
+
+	if (!Library)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Couldn't build DMX rig, no DMX Library set on %s"), *GetName());
+		return;
+	}
+
+	const TArray<UDMXEntityFixturePatch*> Patches = Library->GetEntitiesTypeCast<UDMXEntityFixturePatch>();
+	const int32 fixturesPerRow = FMath::Max(FixturesPerRow, 1);
+	RigFixtures.Reserve(Patches.Num());
+
+	for (UDMXEntityFixturePatch* Patch : Patches)
+	{
+		const TSubclassOf<AActor>* FixtureClass = FixtureClasses.Find(Patch->ParentFixtureTypeTemplate);
+		UClass *Class = FixtureClass && *FixtureClass ? FixtureClass->Get() : DefaultFixtureClass.Get();
+		if (!Class)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Couldn't find a fixture class for DMX Patch %s"), *Patch->Name);
+			continue;
+		}
+
+		const int32 fixtureIndex = RigFixtures.Num();
+		const FVector Location((fixtureIndex % fixturesPerRow) * FixtureSpacing.X, (fixtureIndex / fixturesPerRow) * FixtureSpacing.Y, 0.0f);
+		if (AActor *Fixture = AcquireFixture(Class, FTransform(Location) * GetActorTransform()))
+		{
+			SetFixturePatch(Fixture, Patch);
+			RigFixtures.Add(Fixture);
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("Built DMX rig of %d fixtures from %s"), RigFixtures.Num(), *Library->GetName());
+}
+
+void ALexyVFXDMXRigBuilder::ClearRig()
+{
+#if WITH_EDITOR
+	FScopedTransaction Transaction(NSLOCTEXT("LexyVFXDMXRigBuilder", "ClearRig", "Clear DMX Rig"), !GetWorld()->IsGameWorld());
+#endif
+	Modify();
+
+	for (AActor* Fixture : RigFixtures)
+	{
+		if (IsValid(Fixture))
+			ReleaseFixture(Fixture);
+	}
+	RigFixtures.Reset();
+}
+
+AActor* ALexyVFXDMXRigBuilder::AcquireFixture(UClass *FixtureClass, const FTransform& Transform)
+{
+	if (FLexyVFXDMXFixtureActorPool *Pool = FixturePool.Find(FixtureClass))
+	{
+		while (Pool->Actors.Num() > 0)
+		{
+			AActor *Fixture = Pool->Actors.Pop(false);
+			if (!IsValid(Fixture))
+				continue;
+
+			Fixture->SetActorTransform(Transform);
+			Fixture->SetActorHiddenInGame(false);
+			Fixture->SetActorEnableCollision(true);
+			Fixture->SetActorTickEnabled(true);
+			return Fixture;
+		}
+	}
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.Owner = this;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	return GetWorld()->SpawnActor<AActor>(FixtureClass, Transform, SpawnParameters);
+}
+
+void ALexyVFXDMXRigBuilder::ReleaseFixture(AActor *Fixture)
+{
+	// Pooled fixtures would be saved with the level in the editor
+	if (!GetWorld()->IsGameWorld())
+	{
+		Fixture->Destroy();
+		return;
+	}
+
+	ULexyVFXDMXFunctionManager *FunctionManager = Fixture->FindComponentByClass<ULexyVFXDMXFunctionManager>();
+	ULexyVFXDMXFixtureSubsystem *FixtureSubsystem = ULexyVFXDMXFixtureSubsystem::Get(this);
+	if (FunctionManager && FixtureSubsystem)
+		FixtureSubsystem->UnregisterFixture(FunctionManager);
+
+	Fixture->SetActorHiddenInGame(true);
+	Fixture->SetActorEnableCollision(false);
+	Fixture->SetActorTickEnabled(false);
+	FixturePool.FindOrAdd(Fixture->GetClass()).Actors.Add(Fixture);
+}
+
+void ALexyVFXDMXRigBuilder::SetFixturePatch(AActor *Fixture, UDMXEntityFixturePatch *Patch)
+{
+	UDMXComponent *DMXComp = Fixture->FindComponentByClass<UDMXComponent>();
+	if (!DMXComp)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Couldn't find valid DMX Component on %s"), *Fixture->GetName());
+		return;
+	}
+	DMXComp->SetFixturePatch(Patch);
+
+	// A fixture still waiting for its initialization reads the patch then, a pooled or already initialized one rebinds
+	ULexyVFXDMXFunctionManager *FunctionManager = Fixture->FindComponentByClass<ULexyVFXDMXFunctionManager>();
+	ULexyVFXDMXFixtureSubsystem *FixtureSubsystem = ULexyVFXDMXFixtureSubsystem::Get(this);
+	if (FunctionManager && FunctionManager->bFixtureInitialized && FixtureSubsystem)
+	{
+		FunctionManager->RefreshPatch();
+		FixtureSubsystem->RegisterFixture(FunctionManager);
+		FixtureSubsystem->RequestRebind(FunctionManager);
+	}
+}
@@ -0,0 +1,456 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "LexyVFXDMXSequenceBaker.h"
+#include "LexyVFXDMXFunctionManager.h"
+#include "LexyVFXDMXFixtureType.h"
+#include "LexyVFXDMXMotionSmoother.h"
+#include "DMXRuntime/Public/Library/DMXEntityFixtureType.h"
+#include "DMXRuntime/Public/Sequencer/MovieSceneDMXLibraryTrack.h"
+#include "DMXRuntime/Public/Sequencer/MovieSceneDMXLibrarySection.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "LevelSequence.h"
+#include "MovieScene.h"
+#include "Tracks/MovieSceneFloatTrack.h"
+#include "Tracks/MovieSceneColorTrack.h"
+#include "Tracks/MovieScene3DTransformTrack.h"
+#include "Tracks/MovieSceneMaterialTrack.h"
+#include "Sections/MovieSceneFloatSection.h"
+#include "Sections/MovieSceneColorSection.h"
+#include "Sections/MovieScene3DTransformSection.h"
+#include "Sections/MovieSceneParameterSection.h"
+#include "UObject/UObjectIterator.h"
+
+namespace LexyVFXDMXSequenceBaker
+{
+	typedef TPair<const UMovieSceneDMXLibrarySection*, const FDMXFixturePatchChannel*> FPatchChannelRef;
+
+	static void FindPatchChannels(const UMovieScene *DMXMovieScene, const UDMXEntityFixturePatch *Patch, TArray<FPatchChannelRef>& OutPatchChannels)
+	{
+		for (const UMovieSceneTrack* MasterTrack : DMXMovieScene->GetMasterTracks())
+		{
+			const UMovieSceneDMXLibraryTrack *DMXTrack = Cast<UMovieSceneDMXLibraryTrack>(MasterTrack);
+			if (!DMXTrack)
+				continue;
+
+			for (const UMovieSceneSection* Section : DMXTrack->GetAllSections())
+			{
+				const UMovieSceneDMXLibrarySection *DMXSection = Cast<UMovieSceneDMXLibrarySection>(Section);
+				if (!DMXSection || !DMXSection->IsActive())
+					continue;
+
+				for (const FDMXFixturePatchChannel& PatchChannel : DMXSection->GetFixturePatchChannels())
+				{
+					if (PatchChannel.Reference.GetFixturePatch() == Patch)
+						OutPatchChannels.Add(FPatchChannelRef(DMXSection, &PatchChannel));
+				}
+			}
+		}
+	}
+
+	static void EvaluatePatchChannels(const TArray<FPatchChannelRef>& PatchChannels, FFrameTime Time, TMap<FDMXAttributeName, int32>& OutValues)
+	{
+		for (const FPatchChannelRef& PatchChannelRef : PatchChannels)
+		{
+			if (!PatchChannelRef.Key->GetRange().Contains(Time.FrameNumber))
+				continue;
+
+			const FDMXFixturePatchChannel& PatchChannel = *PatchChannelRef.Value;
+			const UDMXEntityFixturePatch *Patch = PatchChannel.Reference.GetFixturePatch();
+			const UDMXEntityFixtureType *Type = Patch ? Patch->ParentFixtureTypeTemplate : nullptr;
+			if (!Type || !Type->Modes.IsValidIndex(PatchChannel.ActiveMode))
+				continue;
+
+			const TArray<FDMXFixtureFunction>& Functions = Type->Modes[PatchChannel.ActiveMode].Functions;
+			for (int32 i = 0; i != FMath::Min(Functions.Num(), PatchChannel.FunctionChannels.Num()); i++)
+			{
+				float fValue;
+				if (PatchChannel.FunctionChannels[i].bEnabled && PatchChannel.FunctionChannels[i].Channel.Evaluate(Time, fValue))
+					OutValues.Add(Functions[i].Attribute, FMath::RoundToInt(fValue));
+			}
+		}
+	}
+
+	static void WriteReducedCurve(FMovieSceneFloatChannel& Channel, const TArray<FFrameNumber>& Times, const TArray<float>& Values, float Tolerance)
+	{
+		float fMin = Values[0];
+		float fMax = Values[0];
+		for (float fValue : Values)
+		{
+			fMin = FMath::Min(fMin, fValue);
+			fMax = FMath::Max(fMax, fValue);
+		}
+
+		TArray<int32> KeyIndices;
+		ULexyVFXDMXSequenceBaker::ReduceLinearKeys(Values, Tolerance * FMath::Max(fMax - fMin, KINDA_SMALL_NUMBER), KeyIndices);
+
+		Channel.Reset();
+		Channel.SetDefault(Values[0]);
+		for (int32 KeyIndex : KeyIndices)
+		{
+			Channel.AddLinearKey(Times[KeyIndex], Values[KeyIndex]);
+		}
+	}
+
+	// Moves pan, tilt and zoom through the fixture type's motor model like the fixture subsystem does live, one step
+	// per sample. The fixture starts at rest on the first sample.
+	static void SmoothMotion(const ULexyVFXDMXFixtureType& Type, float SampleInterval, TArray<FLexyVFXDMXFixtureOutput>& Samples)
+	{
+		const FVector4 MaxSpeeds = Type.GetMotionMaxSpeeds();
+		const FVector4 MaxAccelerations = Type.GetMotionMaxAccelerations();
+
+		FLexyVFXDMXMotionSmoother MotionSmoother;
+		const int32 slot = MotionSmoother.AddSlot(FVector4(Samples[0].Pan, Samples[0].Tilt, Samples[0].Zoom, 0.0f));
+		for (int32 i = 1; i < Samples.Num(); i++)
+		{
+			FLexyVFXDMXFixtureOutput& Sample = Samples[i];
+			MotionSmoother.SetTarget(slot, FVector4(Sample.Pan, Sample.Tilt, Sample.Zoom, 0.0f), MaxSpeeds, MaxAccelerations);
+			MotionSmoother.Step(SampleInterval);
+
+			const FVector4& Position = MotionSmoother.GetPosition(slot);
+			Sample.Pan = Position[FLexyVFXDMXMotionSmoother::Axis_Pan];
+			Sample.Tilt = Position[FLexyVFXDMXMotionSmoother::Axis_Tilt];
+			Sample.Zoom = Position[FLexyVFXDMXMotionSmoother::Axis_Zoom];
+		}
+	}
+
+	struct FFixtureCurveWriter : public ILexyVFXDMXBakedTracks
+	{
+		ULevelSequence *Sequence;
+		UMovieScene *MovieScene;
+		AActor *Actor;
+		const TArray<FFrameNumber>& Times;
+		const TArray<FLexyVFXDMXFixtureOutput>& Samples;
+		float Tolerance;
+
+		FGuid ActorGuid;
+		TMap<UObject*, FGuid> Bindings;
+		TMap<TPair<UObject*, int32>, UMovieSceneParameterSection*> MaterialSections;
+
+		FFixtureCurveWriter(ULevelSequence *InSequence, AActor *InActor, const TArray<FFrameNumber>& InTimes, const TArray<FLexyVFXDMXFixtureOutput>& InSamples, float InTolerance)
+			: Sequence(InSequence)
+			, MovieScene(InSequence->GetMovieScene())
+			, Actor(InActor)
+			, Times(InTimes)
+			, Samples(InSamples)
+			, Tolerance(InTolerance)
+		{
+			ActorGuid = FindOrAddBinding(Actor, Actor->GetWorld());
+		}
+
+		// Reuses an existing binding for the object, dropping its tracks from a previous bake
+		FGuid FindOrAddBinding(UObject *Object, UObject *Context)
+		{
+			if (const FGuid* ExistingGuid = Bindings.Find(Object))
+				return *ExistingGuid;
+
+			FGuid Guid = Sequence->FindPossessableObjectId(*Object, Context);
+			if (Guid.IsValid() && Object != Actor)
+			{
+				if (const FMovieSceneBinding* Binding = MovieScene->FindBinding(Guid))
+				{
+					const TArray<UMovieSceneTrack*> OldTracks = Binding->GetTracks();
+					for (UMovieSceneTrack* OldTrack : OldTracks)
+					{
+						MovieScene->RemoveTrack(*OldTrack);
+					}
+				}
+			}
+			else if (!Guid.IsValid())
+			{
+				Guid = MovieScene->AddPossessable(Object->GetName(), Object->GetClass());
+				if (Object != Actor)
+					MovieScene->FindPossessable(Guid)->SetParent(ActorGuid);
+				Sequence->BindPossessableObject(Guid, *Object, Context);
+			}
+
+			Bindings.Add(Object, Guid);
+			return Guid;
+		}
+
+		void TransformSamples(TFunctionRef<float(const FLexyVFXDMXFixtureOutput&)> Evaluate, TArray<float>& OutValues) const
+		{
+			OutValues.SetNumUninitialized(Samples.Num());
+			for (int32 i = 0; i != Samples.Num(); i++)
+			{
+				OutValues[i] = Evaluate(Samples[i]);
+			}
+		}
+
+		void WriteColorCurves(FMovieSceneFloatChannel* const* Channels, TFunctionRef<FLinearColor(const FLexyVFXDMXFixtureOutput&)> Evaluate) const
+		{
+			// Red, green, blue, alpha
+			TArray<float> Values;
+			for (int32 c = 0; c != 4; c++)
+			{
+				TransformSamples([c, &Evaluate](const FLexyVFXDMXFixtureOutput& Output) { return Evaluate(Output).Component(c); }, Values);
+				WriteReducedCurve(*Channels[c], Times, Values, Tolerance);
+			}
+		}
+
+		void AddFloatProperty(UActorComponent *Component, FName PropertyName, TFunctionRef<float(const FLexyVFXDMXFixtureOutput&)> Evaluate) override
+		{
+			if (!Component)
+				return;
+
+			UMovieSceneFloatTrack *Track = MovieScene->AddTrack<UMovieSceneFloatTrack>(FindOrAddBinding(Component, Actor));
+			Track->SetPropertyNameAndPath(PropertyName, PropertyName.ToString());
+
+			UMovieSceneFloatSection *Section = Cast<UMovieSceneFloatSection>(Track->CreateNewSection());
+			Section->SetRange(TRange<FFrameNumber>::All());
+			Track->AddSection(*Section);
+
+			TArray<float> Values;
+			TransformSamples(Evaluate, Values);
+			WriteReducedCurve(Section->GetChannel(), Times, Values, Tolerance);
+		}
+
+		void AddLightColor(ULightComponent *LightComponent, TFunctionRef<FLinearColor(const FLexyVFXDMXFixtureOutput&)> Evaluate) override
+		{
+			if (!LightComponent)
+				return;
+
+			const FName PropertyName = GET_MEMBER_NAME_CHECKED(ULightComponentBase, LightColor);
+			UMovieSceneColorTrack *Track = MovieScene->AddTrack<UMovieSceneColorTrack>(FindOrAddBinding(LightComponent, Actor));
+			Track->SetPropertyNameAndPath(PropertyName, PropertyName.ToString());
+
+			UMovieSceneColorSection *Section = Cast<UMovieSceneColorSection>(Track->CreateNewSection());
+			Section->SetRange(TRange<FFrameNumber>::All());
+			Track->AddSection(*Section);
+
+			WriteColorCurves(Section->GetChannelProxy().GetChannels<FMovieSceneFloatChannel>().GetData(), Evaluate);
+		}
+
+		UMovieSceneParameterSection* FindOrAddMaterialSection(UStaticMeshComponent *MeshComponent, int32 MaterialIndex)
+		{
+			const TPair<UObject*, int32> MaterialSlot(MeshComponent, MaterialIndex);
+			if (UMovieSceneParameterSection** ExistingSection = MaterialSections.Find(MaterialSlot))
+				return *ExistingSection;
+
+			UMovieSceneComponentMaterialTrack *Track = MovieScene->AddTrack<UMovieSceneComponentMaterialTrack>(FindOrAddBinding(MeshComponent, Actor));
+			Track->SetMaterialIndex(MaterialIndex);
+
+			UMovieSceneParameterSection *Section = Cast<UMovieSceneParameterSection>(Track->CreateNewSection());
+			Section->SetRange(TRange<FFrameNumber>::All());
+			Track->AddSection(*Section);
+
+			MaterialSections.Add(MaterialSlot, Section);
+			return Section;
+		}
+
+		void AddMaterialScalar(UStaticMeshComponent *MeshComponent, int32 MaterialIndex, FName ParameterName, TFunctionRef<float(const FLexyVFXDMXFixtureOutput&)> Evaluate) override
+		{
+			if (!MeshComponent)
+				return;
+
+			UMovieSceneParameterSection *Section = FindOrAddMaterialSection(MeshComponent, MaterialIndex);
+			Section->AddScalarParameterKey(ParameterName, Times[0], 0.0f);
+
+			for (FScalarParameterNameAndCurve& Parameter : Section->GetScalarParameterNamesAndCurves())
+			{
+				if (Parameter.ParameterName != ParameterName)
+					continue;
+
+				TArray<float> Values;
+				TransformSamples(Evaluate, Values);
+				WriteReducedCurve(Parameter.ParameterCurve, Times, Values, Tolerance);
+			}
+		}
+
+		void AddMaterialColor(UStaticMeshComponent *MeshComponent, int32 MaterialIndex, FName ParameterName, TFunctionRef<FLinearColor(const FLexyVFXDMXFixtureOutput&)> Evaluate) override
+		{
+			if (!MeshComponent)
+				return;
+
+			UMovieSceneParameterSection *Section = FindOrAddMaterialSection(MeshComponent, MaterialIndex);
+			Section->AddColorParameterKey(ParameterName, Times[0], FLinearColor::White);
+
+			for (FColorParameterNameAndCurves& Parameter : Section->GetColorParameterNamesAndCurves())
+			{
+				if (Parameter.ParameterName != ParameterName)
+					continue;
+
+				FMovieSceneFloatChannel* Channels[4] = { &Parameter.RedCurve, &Parameter.GreenCurve, &Parameter.BlueCurve, &Parameter.AlphaCurve };
+				WriteColorCurves(Channels, Evaluate);
+			}
+		}
+
+		void AddRelativeRotation(USceneComponent *SceneComponent, TFunctionRef<FRotator(const FLexyVFXDMXFixtureOutput&)> Evaluate) override
+		{
+			if (!SceneComponent)
+				return;
+
+			UMovieScene3DTransformTrack *Track = MovieScene->AddTrack<UMovieScene3DTransformTrack>(FindOrAddBinding(SceneComponent, Actor));
+
+			UMovieScene3DTransformSection *Section = Cast<UMovieScene3DTransformSection>(Track->CreateNewSection());
+			Section->SetRange(TRange<FFrameNumber>::All());
+			Section->SetMask(FMovieSceneTransformMask(EMovieSceneTransformChannel::Rotation));
+			Track->AddSection(*Section);
+
+			// Translation XYZ, rotation XYZ as roll, pitch, yaw, scale XYZ
+			TArrayView<FMovieSceneFloatChannel*> Channels = Section->GetChannelProxy().GetChannels<FMovieSceneFloatChannel>();
+			TArray<float> Values;
+			TransformSamples([&Evaluate](const FLexyVFXDMXFixtureOutput& Output) { return Evaluate(Output).Roll; }, Values);
+			WriteReducedCurve(*Channels[3], Times, Values, Tolerance);
+			TransformSamples([&Evaluate](const FLexyVFXDMXFixtureOutput& Output) { return Evaluate(Output).Pitch; }, Values);
+			WriteReducedCurve(*Channels[4], Times, Values, Tolerance);
+			TransformSamples([&Evaluate](const FLexyVFXDMXFixtureOutput& Output) { return Evaluate(Output).Yaw; }, Values);
+			WriteReducedCurve(*Channels[5], Times, Values, Tolerance);
+		}
+	};
+
+	static void WriteFixtureCurves(ULevelSequence *TargetSequence, ULexyVFXDMXFunctionManager *Manager, const TArray<FFrameNumber>& Times, const TArray<FLexyVFXDMXFixtureOutput>& Samples, float Tolerance)
+	{
+		FFixtureCurveWriter Writer(TargetSequence, Manager->GetOwner(), Times, Samples, Tolerance);
+
+		for (const ULexyVFXDMXBaseComponent* functionComponent : Manager->LexyVFXFunctionComponents)
+		{
+			functionComponent->DescribeBakedTracks(Writer);
+		}
+	}
+
+	static void BakeCommand(const TArray<FString>& Args, UWorld *World)
+	{
+		if (Args.Num() < 2)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Usage: LexyVFX.DMX.BakeSequence <DMXSequencePath> <TargetSequencePath> [SubSamples] [Tolerance]"));
+			return;
+		}
+
+		ULevelSequence *DMXSequence = LoadObject<ULevelSequence>(nullptr, *Args[0]);
+		ULevelSequence *TargetSequence = LoadObject<ULevelSequence>(nullptr, *Args[1]);
+		const int32 subSamples = Args.Num() > 2 ? FCString::Atoi(*Args[2]) : 1;
+		const float fTolerance = Args.Num() > 3 ? FCString::Atof(*Args[3]) : 0.001f;
+
+		ULexyVFXDMXSequenceBaker::BakeDMXToLevelSequence(World, DMXSequence, TargetSequence, subSamples, fTolerance);
+	}
+
+	static FAutoConsoleCommandWithWorldAndArgs BakeSequenceCommand(
+		TEXT("LexyVFX.DMX.BakeSequence"),
+		TEXT("Bakes the DMX Library track of a Level Sequence through all fixtures into curves on another Level Sequence"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&BakeCommand));
+}
+
+bool ULexyVFXDMXSequenceBaker::BakeDMXToLevelSequence(UObject *WorldContextObject, ULevelSequence *DMXSequence, ULevelSequence *TargetSequence, int32 SubSamples, float Tolerance)
+{
+	using namespace LexyVFXDMXSequenceBaker;
+
+	UWorld *World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	if (!World || !DMXSequence || !TargetSequence || !DMXSequence->GetMovieScene() || !TargetSequence->GetMovieScene())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Couldn't bake DMX: invalid world or sequences"));
+		return false;
+	}
+
+	const UMovieScene *DMXMovieScene = DMXSequence->GetMovieScene();
+	const FFrameRate DMXTickResolution = DMXMovieScene->GetTickResolution();
+	const FFrameRate DMXDisplayRate = DMXMovieScene->GetDisplayRate();
+	const FFrameRate TargetTickResolution = TargetSequence->GetMovieScene()->GetTickResolution();
+	const TRange<FFrameNumber> PlaybackRange = DMXMovieScene->GetPlaybackRange();
+	SubSamples = FMath::Max(SubSamples, 1);
+
+	// Sample times in display frames, so every render node and every temporal sample sees the same values
+	const FFrameNumber startFrame = FFrameRate::TransformTime(PlaybackRange.GetLowerBoundValue(), DMXTickResolution, DMXDisplayRate).FloorToFrame();
+	const FFrameNumber endFrame = FFrameRate::TransformTime(PlaybackRange.GetUpperBoundValue(), DMXTickResolution, DMXDisplayRate).CeilToFrame();
+
+	const float fSampleInterval = float(DMXDisplayRate.AsInterval()) / SubSamples;
+
+	TArray<FFrameTime> SampleTimes;
+	TArray<FFrameNumber> KeyTimes;
+	for (int32 frame = startFrame.Value; frame < endFrame.Value; frame++)
+	{
+		for (int32 subSample = 0; subSample != SubSamples; subSample++)
+		{
+			const FFrameTime DisplayTime(FFrameNumber(frame), float(subSample) / SubSamples);
+			SampleTimes.Add(FFrameRate::TransformTime(DisplayTime, DMXDisplayRate, DMXTickResolution));
+			KeyTimes.Add(FFrameRate::TransformTime(DisplayTime, DMXDisplayRate, TargetTickResolution).RoundToFrame());
+		}
+	}
+
+	if (SampleTimes.Num() == 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Couldn't bake DMX: empty playback range on %s"), *DMXSequence->GetName());
+		return false;
+	}
+
+	TargetSequence->Modify();
+	TargetSequence->GetMovieScene()->Modify();
+
+	int32 bakedFixtures = 0;
+	TArray<FLexyVFXDMXFixtureOutput> Samples;
+	Samples.Reserve(SampleTimes.Num());
+
+	for (TObjectIterator<ULexyVFXDMXFunctionManager> It; It; ++It)
+	{
+		ULexyVFXDMXFunctionManager *Manager = *It;
+		if (Manager->GetWorld() != World || !Manager->Patch)
+			continue;
+
+		TArray<FPatchChannelRef> PatchChannels;
+		FindPatchChannels(DMXMovieScene, Manager->Patch, PatchChannels);
+		if (PatchChannels.Num() == 0)
+			continue;
+
+		// Fixture outputs persist between samples, like they do between packets. Every bake starts from the default
+		// output at full group masters, so it doesn't depend on what the live fixtures last received.
+		Samples.Reset();
+		FLexyVFXDMXFixtureOutput Output;
+		TMap<FDMXAttributeName, int32> DImapDMXFunctionValues;
+		for (const FFrameTime& SampleTime : SampleTimes)
+		{
+			DImapDMXFunctionValues.Reset();
+			EvaluatePatchChannels(PatchChannels, SampleTime, DImapDMXFunctionValues);
+			if (DImapDMXFunctionValues.Num() > 0)
+				Manager->DecodeDMX(DImapDMXFunctionValues, Output);
+			Samples.Add(Output);
+		}
+
+		const ULexyVFXDMXFixtureType *FixtureType = Manager->GetFixtureType();
+		if (FixtureType->bSmoothMotion)
+			SmoothMotion(*FixtureType, fSampleInterval, Samples);
+
+		WriteFixtureCurves(TargetSequence, Manager, KeyTimes, Samples, Tolerance);
+		bakedFixtures++;
+	}
+
+	TargetSequence->MarkPackageDirty();
+	UE_LOG(LogTemp, Warning, TEXT("Baked %d fixtures x %d samples from %s into %s"), bakedFixtures, SampleTimes.Num(), *DMXSequence->GetName(), *TargetSequence->GetName());
+	return bakedFixtures > 0;
+}
+
+void ULexyVFXDMXSequenceBaker::ReduceLinearKeys(const TArray<float>& Values, float Tolerance, TArray<int32>& OutKeyIndices)
+{
+	OutKeyIndices.Reset();
+	if (Values.Num() == 0)
+		return;
+
+	// Keeps extending the current segment while a line from its first key through the candidate end key
+	// stays within Tolerance of every sample in between. The slope window is narrowed incrementally,
+	// so a sample only needs checking once per segment instead of once per candidate end.
+	OutKeyIndices.Add(0);
+	int32 anchor = 0;
+	float fSlopeMin = -BIG_NUMBER;
+	float fSlopeMax = BIG_NUMBER;
+
+	for (int32 i = 1; i < Values.Num(); i++)
+	{
+		const float fDistance = float(i - anchor);
+		const float fSlope = (Values[i] - Values[anchor]) / fDistance;
+
+		if (fSlope < fSlopeMin || fSlope > fSlopeMax)
+		{
+			anchor = i - 1;
+			OutKeyIndices.Add(anchor);
+			fSlopeMin = Values[i] - Tolerance - Values[anchor];
+			fSlopeMax = Values[i] + Tolerance - Values[anchor];
+			continue;
+		}
+
+		fSlopeMin = FMath::Max(fSlopeMin, (Values[i] - Tolerance - Values[anchor]) / fDistance);
+		fSlopeMax = FMath::Min(fSlopeMax, (Values[i] + Tolerance - Values[anchor]) / fDistance);
+	}
+
+	if (OutKeyIndices.Last() != Values.Num() - 1)
+		OutKeyIndices.Add(Values.Num() - 1);
+}
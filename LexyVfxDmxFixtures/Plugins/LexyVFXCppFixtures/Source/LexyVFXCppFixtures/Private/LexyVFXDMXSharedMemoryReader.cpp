@@ -0,0 +1,112 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "LexyVFXDMXSharedMemoryReader.h"
+#include "LexyVFXDMXSharedMemoryLayout.h"
+
+FLexyVFXDMXSharedMemoryReader::~FLexyVFXDMXSharedMemoryReader()
+{
+	Close();
+}
+
+bool FLexyVFXDMXSharedMemoryReader::Open(const FString& InRegionName)
+{
+	Close();
+	RegionName = InRegionName;
+
+	// The ring's size is only known from its header
+	const uint32 accessMode = (uint32)FPlatformMemory::ESharedMemoryAccess::Read;
+	FPlatformMemory::FSharedMemoryRegion *HeaderRegion = FPlatformMemory::MapNamedSharedMemoryRegion(RegionName, false, accessMode, sizeof(LexyVFXDMXShmHeader));
+	if (!HeaderRegion)
+		return false;
+
+	const LexyVFXDMXShmHeader Header = *(const LexyVFXDMXShmHeader*)HeaderRegion->GetAddress();
+	FPlatformMemory::UnmapNamedSharedMemoryRegion(HeaderRegion);
+
+	if (Header.Magic != LEXYVFX_DMX_SHM_MAGIC || Header.Version != LEXYVFX_DMX_SHM_VERSION || Header.SlotCount == 0 || Header.SlotSize < sizeof(LexyVFXDMXShmSlot))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Shared memory region %s isn't a LexyVFX DMX ring"), *RegionName);
+		return false;
+	}
+
+	const SIZE_T regionSize = sizeof(LexyVFXDMXShmHeader) + SIZE_T(Header.SlotCount) * Header.SlotSize;
+	Region = FPlatformMemory::MapNamedSharedMemoryRegion(RegionName, false, accessMode, regionSize);
+	if (!Region)
+		return false;
+
+	const LexyVFXDMXShmHeader *MappedHeader = (const LexyVFXDMXShmHeader*)Region->GetAddress();
+	Slots = (const uint8*)MappedHeader + sizeof(LexyVFXDMXShmHeader);
+	SlotCount = Header.SlotCount;
+	SlotSize = Header.SlotSize;
+
+	// Start from live, frames written before opening are stale
+	ReadSequence = FPlatformAtomics::AtomicRead((volatile const int64*)&MappedHeader->WriteSequence);
+	FramesRead = 0;
+	FramesSkipped = 0;
+	FramesTorn = 0;
+	return true;
+}
+
+void FLexyVFXDMXSharedMemoryReader::Close()
+{
+	if (Region)
+		FPlatformMemory::UnmapNamedSharedMemoryRegion(Region);
+
+	Region = nullptr;
+	Slots = nullptr;
+	SlotCount = 0;
+	SlotSize = 0;
+}
+
+int32 FLexyVFXDMXSharedMemoryReader::Poll(TFunctionRef<void(int32 Universe, TArrayView<const uint8> DMXBuffer)> ReadFrame)
+{
+	if (!Region)
+		return 0;
+
+	const LexyVFXDMXShmHeader *Header = (const LexyVFXDMXShmHeader*)Region->GetAddress();
+	const int64 safeFrames = FMath::Max<int64>(SlotCount / 2, 1);
+
+	int64 writeSequence = FPlatformAtomics::AtomicRead((volatile const int64*)&Header->WriteSequence);
+	if (writeSequence < ReadSequence)
+		ReadSequence = writeSequence; // writer restarted in the same region
+
+	int32 numRead = 0;
+	while (ReadSequence < writeSequence)
+	{
+		// Frames the writer is about to wrap around to are skipped
+		writeSequence = FPlatformAtomics::AtomicRead((volatile const int64*)&Header->WriteSequence);
+		if (writeSequence - ReadSequence > safeFrames)
+		{
+			FramesSkipped += writeSequence - safeFrames - ReadSequence;
+			ReadSequence = writeSequence - safeFrames;
+		}
+
+		const LexyVFXDMXShmSlot *Slot = (const LexyVFXDMXShmSlot*)(Slots + SIZE_T(ReadSequence % SlotCount) * SlotSize);
+		const int64 completeSequence = 2 * ReadSequence + 2;
+		if (FPlatformAtomics::AtomicRead((volatile const int64*)&Slot->Sequence) == completeSequence)
+		{
+			// Copied out first, the frame is only handed out if the writer didn't touch the slot while it was copied
+			const int32 universe = Slot->Universe;
+			const int32 length = FMath::Min<int32>(Slot->Length, LEXYVFX_DMX_SHM_UNIVERSE_SIZE);
+			FMemory::Memcpy(Scratch, Slot->Data, length);
+			FPlatformMisc::MemoryBarrier();
+
+			if (FPlatformAtomics::AtomicRead((volatile const int64*)&Slot->Sequence) == completeSequence)
+			{
+				ReadFrame(universe, TArrayView<const uint8>(Scratch, length));
+				FramesRead++;
+				numRead++;
+			}
+			else
+			{
+				FramesTorn++;
+			}
+		}
+		else
+		{
+			FramesSkipped++;
+		}
+		ReadSequence++;
+	}
+	return numRead;
+}
@@ -2,17 +2,65 @@
 
 
 #include "LexyVFXDMXTiltComponent.h"
+#include "LexyVFXDMXFixtureType.h"
+#include "LexyVFXDMXDecoders.h"
 
-void ULexyVFXDMXTiltComponent::BeginPlay()
+namespace LexyVFXDMXTiltComponent
 {
-	Super::BeginPlay();
-	this->SetParentDMXRef();
-	this->InitDMXFunctionNames(TArray<FName>({ "Tilt" }));
+	template<EDMXParameterBitDepth BitDepth>
+	struct TTiltDecoder
+	{
+		static void Decode(const ULexyVFXDMXFixtureType& Type, const int32 *ChannelValues, const int32 *ChannelIndices, FLexyVFXDMXFixtureOutput& Output)
+		{
+			Output.Tilt = TLexyVFXDMXDecoder<BitDepth>::MapCentered(ChannelValues[ChannelIndices[0]], Type.fTiltRange);
+		}
+	};
 
-	SMRef_Head = Cast<UStaticMeshComponent>(this->FindComponentsByName(UStaticMeshComponent::StaticClass(), TArray<FString>({ "head" }))[0]);
+	// The head rolls in the yoke
+	static FRotator GetHeadRotation(const FLexyVFXDMXFixtureOutput& Output)
+	{
+		return FRotator(0.0f, 0.0f, Output.Tilt);
+	}
 }
 
-void ULexyVFXDMXTiltComponent::UpdateDMX(TMap<FDMXAttributeName, int32> DImapDMXFunctionValues, TArray<FName> nDMXComponentFunctions)
+void ULexyVFXDMXTiltComponent::BindComponents()
 {
-	this->UpdateDMXRotation(tiltBitDepth, SMRef_Head, EDMXRotationMode::RotationMode_Tilt, fTiltRange, DImapDMXFunctionValues, this->FunctionNames.nDMXComponentFunctions[0]);
-}
\ No newline at end of file
+	SMRef_Head = this->FindFirstComponentByName<UStaticMeshComponent>(this->GetFixtureType()->HeadSearchNames);
+}
+
+FLexyVFXDMXDecodeFunction ULexyVFXDMXTiltComponent::SelectDecoder(const ULexyVFXDMXFixtureType& Type) const
+{
+	return LexyVFXDMXDecoders::Select<LexyVFXDMXTiltComponent::TTiltDecoder>(Type.tiltBitDepth);
+}
+
+const TArray<FName>& ULexyVFXDMXTiltComponent::GetFunctionNames(const ULexyVFXDMXFixtureType& Type) const
+{
+	return Type.TiltFunctionNames.nDMXComponentFunctions;
+}
+
+#if WITH_EDITORONLY_DATA
+bool ULexyVFXDMXTiltComponent::MigrateDeprecatedConfig(ULexyVFXDMXFixtureType& Type) const
+{
+	if (tiltBitDepth_DEPRECATED == Type.tiltBitDepth && fTiltRange_DEPRECATED == Type.fTiltRange)
+		return false;
+
+	Type.tiltBitDepth = tiltBitDepth_DEPRECATED;
+	Type.fTiltRange = fTiltRange_DEPRECATED;
+	return true;
+}
+#endif
+
+void ULexyVFXDMXTiltComponent::ApplyOutput(const FLexyVFXDMXFixtureOutput& Output)
+{
+	using namespace LexyVFXDMXTiltComponent;
+
+	if (SMRef_Head)
+		SMRef_Head->SetRelativeRotation(GetHeadRotation(Output).Quaternion());
+}
+
+void ULexyVFXDMXTiltComponent::DescribeBakedTracks(ILexyVFXDMXBakedTracks& Tracks) const
+{
+	using namespace LexyVFXDMXTiltComponent;
+
+	Tracks.AddRelativeRotation(SMRef_Head, &GetHeadRotation);
+}
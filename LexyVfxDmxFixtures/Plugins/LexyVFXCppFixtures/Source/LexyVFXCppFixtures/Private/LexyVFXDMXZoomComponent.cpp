@@ -2,27 +2,93 @@
 
 
 #include "LexyVFXDMXZoomComponent.h"
+#include "LexyVFXDMXFixtureType.h"
+#include "LexyVFXDMXDecoders.h"
 
-void ULexyVFXDMXZoomComponent::BeginPlay()
+namespace LexyVFXDMXZoomComponent
 {
-	Super::BeginPlay();
-	this->SetParentDMXRef();
-	this->InitDMXFunctionNames(TArray<FName>({ "Zoom" }));
+	template<EDMXParameterBitDepth BitDepth>
+	struct TZoomDecoder
+	{
+		static void Decode(const ULexyVFXDMXFixtureType& Type, const int32 *ChannelValues, const int32 *ChannelIndices, FLexyVFXDMXFixtureOutput& Output)
+		{
+			Output.Zoom = TLexyVFXDMXDecoder<BitDepth>::Normalize(ChannelValues[ChannelIndices[0]]);
+		}
+	};
 
-	SPRef_LensSpringArm = Cast<USpringArmComponent>(this->FindComponentsByName(USpringArmComponent::StaticClass(), TArray<FString>({ "spring" }))[0]);
+	static const FName nZoomParameter(TEXT("DMX Zoom"));
 
-	SpotRef_Light = Cast<USpotLightComponent>(this->FindComponentsByName(USpotLightComponent::StaticClass(), TArray<FString>({ "spot" }))[0]);
+	// Spot light cones and the beam material's zoom, relative to the fixture type's beam angle
+	static const float fOuterConeScale = 0.7f;
+	static const float fInnerConeScale = 0.49f;
+	static const float fBeamZoomScale = 1.3f;
+}
+
+void ULexyVFXDMXZoomComponent::BindComponents()
+{
+	const ULexyVFXDMXFixtureType *Type = this->GetFixtureType();
+
+	SPRef_LensSpringArm = this->FindFirstComponentByName<USpringArmComponent>(Type->SpringArmSearchNames);
+
+	SpotRef_Light = this->FindFirstComponentByName<USpotLightComponent>(Type->SpotSearchNames);
+
+	SMRef_Beam = this->FindFirstComponentByName<UStaticMeshComponent>(Type->BeamSearchNames);
+
+	// Recreated for a mesh bound again after a fixture type edit, so parameters don't keep going to the old mesh
+	miBeam = BindDynamicMaterial(SMRef_Beam);
+}
+
+FLexyVFXDMXDecodeFunction ULexyVFXDMXZoomComponent::SelectDecoder(const ULexyVFXDMXFixtureType& Type) const
+{
+	return LexyVFXDMXDecoders::Select<LexyVFXDMXZoomComponent::TZoomDecoder>(Type.zoomBitDepth);
+}
 
-	SMRef_Beam = Cast<UStaticMeshComponent>(this->FindComponentsByName(UStaticMeshComponent::StaticClass(), TArray<FString>({ "beam" }))[0]);
+const TArray<FName>& ULexyVFXDMXZoomComponent::GetFunctionNames(const ULexyVFXDMXFixtureType& Type) const
+{
+	return Type.ZoomFunctionNames.nDMXComponentFunctions;
+}
+
+#if WITH_EDITORONLY_DATA
+bool ULexyVFXDMXZoomComponent::MigrateDeprecatedConfig(ULexyVFXDMXFixtureType& Type) const
+{
+	if (zoomBitDepth_DEPRECATED == Type.zoomBitDepth && fBeamRangeLinear_DEPRECATED == Type.fBeamRangeLinear && fBeamRangeMin_DEPRECATED == Type.fBeamRangeMin && fBeamRangeMax_DEPRECATED == Type.fBeamRangeMax)
+		return false;
 
-	miBeam = SMRef_Beam->CreateDynamicMaterialInstance(0, SMRef_Beam->GetMaterial(0));
+	Type.zoomBitDepth = zoomBitDepth_DEPRECATED;
+	Type.fBeamRangeLinear = fBeamRangeLinear_DEPRECATED;
+	Type.fBeamRangeMin = fBeamRangeMin_DEPRECATED;
+	Type.fBeamRangeMax = fBeamRangeMax_DEPRECATED;
+	return true;
 }
+#endif
 
-void ULexyVFXDMXZoomComponent::UpdateDMX(TMap<FDMXAttributeName, int32> DImapDMXFunctionValues, TArray<FName> nDMXComponentFunctions)
+void ULexyVFXDMXZoomComponent::ApplyOutput(const FLexyVFXDMXFixtureOutput& Output)
 {
-	this->UpdateDMXSpringArm(zoomBitDepth, SPRef_LensSpringArm, fBeamRangeLinear, DImapDMXFunctionValues, this->FunctionNames.nDMXComponentFunctions[0]);
+	using namespace LexyVFXDMXZoomComponent;
+
+	const ULexyVFXDMXFixtureType *Type = this->GetFixtureType();
+	const float fBeamAngle = Type->GetBeamAngle(Output.Zoom);
+
+	if (SPRef_LensSpringArm)
+		SPRef_LensSpringArm->TargetArmLength = Type->GetSpringArmLength(Output.Zoom);
 
-	this->UpdateDMXMaterialScalarParameter(miBeam, zoomBitDepth, FName("DMX Zoom"), 1.3f, fBeamRangeMax, fBeamRangeMin, DImapDMXFunctionValues, this->FunctionNames.nDMXComponentFunctions[0]);
+	if (miBeam)
+		miBeam->SetScalarParameterValue(nZoomParameter, fBeamZoomScale * fBeamAngle);
 
-	this->UpdateDMXSpotConeAngle(zoomBitDepth, SpotRef_Light, fBeamRangeMax, fBeamRangeMin, DImapDMXFunctionValues, this->FunctionNames.nDMXComponentFunctions[0]);
-}
\ No newline at end of file
+	if (SpotRef_Light)
+	{
+		SpotRef_Light->SetOuterConeAngle(fOuterConeScale * fBeamAngle);
+		SpotRef_Light->SetInnerConeAngle(fInnerConeScale * fBeamAngle);
+	}
+}
+
+void ULexyVFXDMXZoomComponent::DescribeBakedTracks(ILexyVFXDMXBakedTracks& Tracks) const
+{
+	using namespace LexyVFXDMXZoomComponent;
+
+	const ULexyVFXDMXFixtureType *Type = this->GetFixtureType();
+	Tracks.AddFloatProperty(SPRef_LensSpringArm, GET_MEMBER_NAME_CHECKED(USpringArmComponent, TargetArmLength), [Type](const FLexyVFXDMXFixtureOutput& Output) { return Type->GetSpringArmLength(Output.Zoom); });
+	Tracks.AddMaterialScalar(SMRef_Beam, DynamicMaterialIndex, nZoomParameter, [Type](const FLexyVFXDMXFixtureOutput& Output) { return fBeamZoomScale * Type->GetBeamAngle(Output.Zoom); });
+	Tracks.AddFloatProperty(SpotRef_Light, GET_MEMBER_NAME_CHECKED(USpotLightComponent, OuterConeAngle), [Type](const FLexyVFXDMXFixtureOutput& Output) { return fOuterConeScale * Type->GetBeamAngle(Output.Zoom); });
+	Tracks.AddFloatProperty(SpotRef_Light, GET_MEMBER_NAME_CHECKED(USpotLightComponent, InnerConeAngle), [Type](const FLexyVFXDMXFixtureOutput& Output) { return fInnerConeScale * Type->GetBeamAngle(Output.Zoom); });
+}
@@ -0,0 +1,169 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "LexyVFXDMXClusterReplicator.h"
+#include "LexyVFXDMXFixtureType.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace LexyVFXDMXClusterReplicatorTests
+{
+	// Away from the LexyVFX.DMX.Cluster defaults, so a running cluster on the machine isn't disturbed
+	static const TCHAR* GroupAddress = TEXT("239.255.76.89");
+	static const int32 Port = 7689;
+
+	static FLexyVFXDMXQuantizedOutput MakeOutput(uint16 Value)
+	{
+		FLexyVFXDMXQuantizedOutput outQuantized;
+		for (int32 i = 0; i != FLexyVFXDMXQuantizedOutput::Field_Count; i++)
+		{
+			outQuantized.Values[i] = uint16(Value + i);
+		}
+		return outQuantized;
+	}
+
+	// One datagram per frame, fixture 1 set to FirstValue + the frame's index
+	static void SendFrames(FLexyVFXDMXClusterReplicator& Primary, uint32 FirstFrame, int32 NumFrames, uint16 FirstValue)
+	{
+		for (int32 i = 0; i != NumFrames; i++)
+		{
+			Primary.BeginFrame(FirstFrame + i, false, 30);
+			Primary.WriteFixture(1, MakeOutput(FirstValue + i));
+			Primary.EndFrame();
+		}
+	}
+
+	// Loopback delivers within milliseconds, the timeout only keeps a blocked socket from hanging the test
+	static bool ReceiveDatagrams(FLexyVFXDMXClusterReplicator& Secondary, uint64 NumDatagrams)
+	{
+		const double timeoutSeconds = FPlatformTime::Seconds() + 2.0;
+		while (Secondary.DatagramsReceived < NumDatagrams && FPlatformTime::Seconds() < timeoutSeconds)
+		{
+			Secondary.ReceiveFrames();
+			FPlatformProcess::Sleep(0.001f);
+		}
+		return Secondary.DatagramsReceived == NumDatagrams;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLexyVFXDMXClusterDatagramTest, "LexyVFX.DMX.Cluster.Datagram", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FLexyVFXDMXClusterDatagramTest::RunTest(const FString& Parameters)
+{
+	using namespace LexyVFXDMXClusterReplicatorTests;
+
+	const FLexyVFXDMXQuantizedOutput Full = MakeOutput(1000);
+	const FLexyVFXDMXQuantizedOutput Changed = MakeOutput(2000);
+	const uint8 fullMask = (1 << FLexyVFXDMXQuantizedOutput::Field_Count) - 1;
+	const uint8 panTiltMask = (1 << FLexyVFXDMXQuantizedOutput::Field_Pan) | (1 << FLexyVFXDMXQuantizedOutput::Field_Tilt);
+
+	TArray<uint8> Datagram;
+	FLexyVFXDMXClusterReplicator::WriteHeader(Datagram, FLexyVFXDMXClusterReplicator::Flag_Keyframe, 42, 7, 2);
+	FLexyVFXDMXClusterReplicator::WriteRecord(Datagram, 11, fullMask, Full);
+	FLexyVFXDMXClusterReplicator::WriteRecord(Datagram, 12, panTiltMask, Changed);
+
+	uint8 Flags;
+	uint32 FrameNumber;
+	uint32 DatagramSequence;
+	TArray<FLexyVFXDMXClusterReplicator::FRecord> Records;
+	if (!TestTrue(TEXT("Datagram parses"), FLexyVFXDMXClusterReplicator::ParseDatagram(Datagram, Flags, FrameNumber, DatagramSequence, Records)))
+		return false;
+
+	TestEqual(TEXT("Flags"), Flags, uint8(FLexyVFXDMXClusterReplicator::Flag_Keyframe));
+	TestEqual(TEXT("Frame number"), FrameNumber, 42u);
+	TestEqual(TEXT("Datagram sequence"), DatagramSequence, 7u);
+	if (!TestEqual(TEXT("Records"), Records.Num(), 2))
+		return false;
+
+	TestEqual(TEXT("Full record fixture"), Records[0].FixtureId, 11u);
+	TestEqual(TEXT("Full record mask"), Records[0].Mask, fullMask);
+	TestEqual(TEXT("Full record fields"), FMemory::Memcmp(Records[0].Output.Values, Full.Values, sizeof(Full.Values)), 0);
+	TestEqual(TEXT("Delta record mask"), Records[1].Mask, panTiltMask);
+	TestEqual(TEXT("Delta record pan"), Records[1].Output.Values[FLexyVFXDMXQuantizedOutput::Field_Pan], Changed.Values[FLexyVFXDMXQuantizedOutput::Field_Pan]);
+	TestEqual(TEXT("Delta record tilt"), Records[1].Output.Values[FLexyVFXDMXQuantizedOutput::Field_Tilt], Changed.Values[FLexyVFXDMXQuantizedOutput::Field_Tilt]);
+
+	// A cut off datagram is rejected instead of read past its end
+	Datagram.SetNum(Datagram.Num() - 1);
+	TestFalse(TEXT("Truncated datagram parses"), FLexyVFXDMXClusterReplicator::ParseDatagram(Datagram, Flags, FrameNumber, DatagramSequence, Records));
+
+	// Quantization stays within one step of the fixture type's ranges
+	const ULexyVFXDMXFixtureType& Type = *ULexyVFXDMXFixtureType::GetDefaultType();
+	FLexyVFXDMXFixtureOutput Output;
+	Output.Dimmer = 0.3f;
+	Output.Color = FLinearColor(0.1f, 0.5f, 0.9f, 1.0f);
+	Output.Zoom = 0.75f;
+	Output.Pan = Type.fPanRange * 0.2f;
+	Output.Tilt = Type.fTiltRange * -0.4f;
+	const FLexyVFXDMXFixtureOutput Dequantized = FLexyVFXDMXQuantizedOutput::Quantize(Output, Type).Dequantize(Type);
+	TestEqual(TEXT("Dequantized dimmer"), Dequantized.Dimmer, Output.Dimmer, 1.0f / 65535.0f);
+	TestTrue(TEXT("Dequantized color"), Dequantized.Color.Equals(Output.Color, 1.0f / 65535.0f));
+	TestEqual(TEXT("Dequantized zoom"), Dequantized.Zoom, Output.Zoom, 1.0f / 65535.0f);
+	TestEqual(TEXT("Dequantized pan"), Dequantized.Pan, Output.Pan, Type.fPanRange / 65535.0f);
+	TestEqual(TEXT("Dequantized tilt"), Dequantized.Tilt, Output.Tilt, Type.fTiltRange / 65535.0f);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLexyVFXDMXClusterLoopbackTest, "LexyVFX.DMX.Cluster.Loopback", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FLexyVFXDMXClusterLoopbackTest::RunTest(const FString& Parameters)
+{
+	using namespace LexyVFXDMXClusterReplicatorTests;
+
+	FLexyVFXDMXClusterReplicator Secondary;
+	TUniquePtr<FLexyVFXDMXClusterReplicator> Primary = MakeUnique<FLexyVFXDMXClusterReplicator>();
+	if (!Secondary.InitSecondary(GroupAddress, Port) || !Primary->InitPrimary(GroupAddress, Port))
+	{
+		AddWarning(FString::Printf(TEXT("Couldn't open multicast sockets on %s:%d, skipped"), GroupAddress, Port));
+		return true;
+	}
+
+	TArray<TPair<uint32, FLexyVFXDMXQuantizedOutput>> Applied;
+	auto ApplyFixture = [&Applied](uint32 FixtureId, const FLexyVFXDMXQuantizedOutput& Quantized)
+	{
+		Applied.Emplace(FixtureId, Quantized);
+	};
+
+	// Frames behind the newest are held back, the latest applied one wins
+	SendFrames(*Primary, 1000, 5, 100);
+	if (!TestTrue(TEXT("Received the first frames"), ReceiveDatagrams(Secondary, 5)))
+		return false;
+
+	Secondary.ConsumeFrames(2, true, ApplyFixture);
+	TestEqual(TEXT("Fixtures applied two frames behind"), Applied.Num(), 1);
+	if (Applied.Num() == 1)
+		TestEqual(TEXT("Fixture value two frames behind"), Applied[0].Value.Values[0], uint16(102));
+
+	// Past the reorder distance, so the restarted primary's sequence falls far behind the last one received
+	Applied.Reset();
+	SendFrames(*Primary, 1005, 300, 200);
+	if (!TestTrue(TEXT("Received the frames before the restart"), ReceiveDatagrams(Secondary, 305)))
+		return false;
+	Secondary.ConsumeFrames(0, true, ApplyFixture);
+
+	// A restarted primary counts frames and datagrams from 0 again
+	Primary = MakeUnique<FLexyVFXDMXClusterReplicator>();
+	if (!TestTrue(TEXT("Primary restarts"), Primary->InitPrimary(GroupAddress, Port)))
+		return false;
+
+	Applied.Reset();
+	SendFrames(*Primary, 0, 3, 500);
+	if (!TestTrue(TEXT("Received the frames after the restart"), ReceiveDatagrams(Secondary, 308)))
+		return false;
+
+	Secondary.ConsumeFrames(2, true, ApplyFixture);
+	TestEqual(TEXT("Restarts detected"), Secondary.Restarts, uint64(1));
+	TestEqual(TEXT("Datagrams lost"), Secondary.DatagramsLost, uint64(0));
+	TestEqual(TEXT("Fixtures applied after the restart"), Applied.Num(), 1);
+	if (Applied.Num() == 1)
+	{
+		TestEqual(TEXT("Fixture id after the restart"), Applied[0].Key, 1u);
+		TestEqual(TEXT("Fixture value still two frames behind after the restart"), Applied[0].Value.Values[0], uint16(500));
+	}
+	return true;
+}
+
+#endif
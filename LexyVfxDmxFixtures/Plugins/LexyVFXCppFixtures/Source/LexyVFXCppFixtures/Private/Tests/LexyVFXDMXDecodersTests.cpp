@@ -0,0 +1,64 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "LexyVFXDMXDecoders.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace LexyVFXDMXDecodersTests
+{
+	// Counts values that don't round-trip back to their DMX value, and values that collapse onto their predecessor
+	template<EDMXParameterBitDepth BitDepth>
+	static void CountPrecisionLoss(float RangeMin, float RangeMax, int64& OutNotRecoverable, int64& OutCollapsed)
+	{
+		const uint32 maxValue = TLexyVFXDMXBitDepth<BitDepth>::MaxValue;
+		const double range = double(RangeMax) - double(RangeMin);
+
+		OutNotRecoverable = 0;
+		OutCollapsed = 0;
+		float fPrevious = 0.0f;
+		for (uint32 value = 0; value <= maxValue; value++)
+		{
+			const float fMapped = TLexyVFXDMXDecoder<BitDepth>::MapRange(int32(value), RangeMin, RangeMax);
+			if (FMath::RoundToDouble((double(fMapped) - RangeMin) / range * maxValue) != double(value))
+				OutNotRecoverable++;
+			if (value > 0 && fMapped <= fPrevious)
+				OutCollapsed++;
+			fPrevious = fMapped;
+		}
+	}
+
+	template<EDMXParameterBitDepth BitDepth>
+	static void VerifyBitDepth(FAutomationTestBase& Test, const TCHAR *Name, float RangeMin, float RangeMax)
+	{
+		const FString Context = FString::Printf(TEXT("%s %.1f-%.1f"), Name, RangeMin, RangeMax);
+
+		int64 notRecoverable, collapsed;
+		CountPrecisionLoss<BitDepth>(RangeMin, RangeMax, notRecoverable, collapsed);
+		Test.TestEqual(Context + TEXT(" values not recoverable"), notRecoverable, int64(0));
+		Test.TestEqual(Context + TEXT(" values collapsed"), collapsed, int64(0));
+
+		Test.TestEqual(Context + TEXT(" at 0"), TLexyVFXDMXDecoder<BitDepth>::MapRange(0, RangeMin, RangeMax), RangeMin, 0.0f);
+		Test.TestEqual(Context + TEXT(" at max"), TLexyVFXDMXDecoder<BitDepth>::MapRange(TLexyVFXDMXBitDepth<BitDepth>::MaxValue, RangeMin, RangeMax), RangeMax, 0.0f);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLexyVFXDMXDecoderPrecisionTest, "LexyVFX.DMX.Decoders.Precision", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+// Every 8, 16 and 24 bit DMX value decodes to a distinct value that rounds back to it
+bool FLexyVFXDMXDecoderPrecisionTest::RunTest(const FString& Parameters)
+{
+	using namespace LexyVFXDMXDecodersTests;
+
+	VerifyBitDepth<EDMXParameterBitDepth::BitDepth_8bits>(*this, TEXT("8 bit"), 0.0f, 1.0f);
+	VerifyBitDepth<EDMXParameterBitDepth::BitDepth_16bits>(*this, TEXT("16 bit"), 0.0f, 1.0f);
+	VerifyBitDepth<EDMXParameterBitDepth::BitDepth_16bits>(*this, TEXT("16 bit pan"), -270.0f, 270.0f);
+	VerifyBitDepth<EDMXParameterBitDepth::BitDepth_24bits>(*this, TEXT("24 bit"), 0.0f, 1.0f);
+	VerifyBitDepth<EDMXParameterBitDepth::BitDepth_24bits>(*this, TEXT("24 bit pan"), -270.0f, 270.0f);
+	VerifyBitDepth<EDMXParameterBitDepth::BitDepth_24bits>(*this, TEXT("24 bit tilt"), -125.0f, 125.0f);
+	return true;
+}
+
+#endif
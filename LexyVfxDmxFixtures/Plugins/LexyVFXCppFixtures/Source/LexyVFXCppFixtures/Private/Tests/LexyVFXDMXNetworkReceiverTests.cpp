@@ -0,0 +1,128 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "LexyVFXDMXNetworkReceiver.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace LexyVFXDMXNetworkReceiverTests
+{
+	static void WriteBigEndian16(TArray<uint8>& Packet, int32 Offset, uint16 Value)
+	{
+		Packet[Offset] = uint8(Value >> 8);
+		Packet[Offset + 1] = uint8(Value & 0xFF);
+	}
+
+	static void WriteBigEndian32(TArray<uint8>& Packet, int32 Offset, uint32 Value)
+	{
+		WriteBigEndian16(Packet, Offset, uint16(Value >> 16));
+		WriteBigEndian16(Packet, Offset + 2, uint16(Value & 0xFFFF));
+	}
+
+	static TArray<uint8> MakeLevels(int32 NumChannels)
+	{
+		TArray<uint8> Levels;
+		for (int32 channel = 0; channel != NumChannels; channel++)
+		{
+			Levels.Add(uint8(channel * 7));
+		}
+		return Levels;
+	}
+
+	static TArray<uint8> MakeArtDmx(uint8 Net, uint8 SubUni, const TArray<uint8>& Levels)
+	{
+		TArray<uint8> Packet;
+		Packet.SetNumZeroed(18);
+		FMemory::Memcpy(Packet.GetData(), "Art-Net", 8);
+		Packet[8] = 0x00;
+		Packet[9] = 0x50;
+		Packet[11] = 14;
+		Packet[14] = SubUni;
+		Packet[15] = Net;
+		WriteBigEndian16(Packet, 16, uint16(Levels.Num()));
+		Packet.Append(Levels);
+		return Packet;
+	}
+
+	static TArray<uint8> MakeSACN(const FGuid& CID, uint8 Priority, uint16 Universe, uint8 Options, const TArray<uint8>& Levels)
+	{
+		TArray<uint8> Packet;
+		Packet.SetNumZeroed(126);
+		WriteBigEndian16(Packet, 0, 0x0010);
+		FMemory::Memcpy(&Packet[4], "ASC-E1.17\0\0\0", 12);
+		WriteBigEndian32(Packet, 18, 0x00000004);
+		for (int32 i = 0; i != 4; i++)
+		{
+			WriteBigEndian32(Packet, 22 + 4 * i, CID[i]);
+		}
+		WriteBigEndian32(Packet, 40, 0x00000002);
+		Packet[108] = Priority;
+		Packet[112] = Options;
+		WriteBigEndian16(Packet, 113, Universe);
+		Packet[117] = 0x02;
+		Packet[118] = 0xA1;
+		WriteBigEndian16(Packet, 121, 1);
+		WriteBigEndian16(Packet, 123, uint16(Levels.Num() + 1));
+		Packet.Append(Levels);
+		return Packet;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLexyVFXDMXNetworkPacketTest, "LexyVFX.DMX.Merge.NetworkPackets", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FLexyVFXDMXNetworkPacketTest::RunTest(const FString& Parameters)
+{
+	using namespace LexyVFXDMXNetworkReceiverTests;
+
+	const TArray<uint8> Levels = MakeLevels(512);
+	int32 universe;
+	TArrayView<const uint8> DMXBuffer;
+
+	// Art-Net port address 0x1234 is net 0x12, sub-net 3, universe 4
+	TArray<uint8> ArtDmx = MakeArtDmx(0x12, 0x34, Levels);
+	if (TestTrue(TEXT("ArtDmx parses"), FLexyVFXDMXNetworkReceiver::ParseArtDmx(ArtDmx, universe, DMXBuffer)))
+	{
+		TestEqual(TEXT("ArtDmx universe"), universe, 0x1234);
+		TestTrue(TEXT("ArtDmx levels"), DMXBuffer.Num() == Levels.Num() && FMemory::Memcmp(DMXBuffer.GetData(), Levels.GetData(), Levels.Num()) == 0);
+	}
+
+	ArtDmx.SetNum(ArtDmx.Num() - 1);
+	TestFalse(TEXT("Truncated ArtDmx parses"), FLexyVFXDMXNetworkReceiver::ParseArtDmx(ArtDmx, universe, DMXBuffer));
+
+	// ArtPoll and other opcodes carry no levels
+	ArtDmx = MakeArtDmx(0, 1, Levels);
+	ArtDmx[9] = 0x20;
+	TestFalse(TEXT("ArtPoll parses"), FLexyVFXDMXNetworkReceiver::ParseArtDmx(ArtDmx, universe, DMXBuffer));
+
+	const FGuid CID(0x01234567, 0x89ABCDEF, 0xFEDCBA98, 0x76543210);
+	FGuid ParsedCID;
+	int32 priority;
+	TArray<uint8> SACN = MakeSACN(CID, 150, 42, 0, MakeLevels(24));
+	if (TestTrue(TEXT("sACN parses"), FLexyVFXDMXNetworkReceiver::ParseSACN(SACN, ParsedCID, priority, universe, DMXBuffer)))
+	{
+		TestTrue(TEXT("sACN CID"), ParsedCID == CID);
+		TestEqual(TEXT("sACN priority"), priority, 150);
+		TestEqual(TEXT("sACN universe"), universe, 42);
+		TestEqual(TEXT("sACN levels"), DMXBuffer.Num(), 24);
+		if (DMXBuffer.Num() == 24)
+			TestEqual(TEXT("sACN last level"), int32(DMXBuffer[23]), 23 * 7);
+	}
+
+	SACN[125] = 0xDD;
+	TestFalse(TEXT("sACN with a non-null start code parses"), FLexyVFXDMXNetworkReceiver::ParseSACN(SACN, ParsedCID, priority, universe, DMXBuffer));
+
+	SACN = MakeSACN(CID, 100, 1, 0x80, Levels);
+	TestFalse(TEXT("sACN preview data parses"), FLexyVFXDMXNetworkReceiver::ParseSACN(SACN, ParsedCID, priority, universe, DMXBuffer));
+
+	SACN = MakeSACN(CID, 100, 1, 0x40, Levels);
+	TestFalse(TEXT("Terminated sACN stream parses"), FLexyVFXDMXNetworkReceiver::ParseSACN(SACN, ParsedCID, priority, universe, DMXBuffer));
+
+	SACN = MakeSACN(CID, 100, 1, 0, Levels);
+	SACN.SetNum(SACN.Num() - 1);
+	TestFalse(TEXT("Truncated sACN parses"), FLexyVFXDMXNetworkReceiver::ParseSACN(SACN, ParsedCID, priority, universe, DMXBuffer));
+	return true;
+}
+
+#endif
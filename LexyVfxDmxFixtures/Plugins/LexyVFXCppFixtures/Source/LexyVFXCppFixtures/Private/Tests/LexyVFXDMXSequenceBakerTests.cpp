@@ -0,0 +1,106 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "LexyVFXDMXSequenceBaker.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace LexyVFXDMXSequenceBakerTests
+{
+	// Largest distance of any sample from the line through the kept keys around it
+	static float MaxInterpolationError(const TArray<float>& Values, const TArray<int32>& KeyIndices)
+	{
+		float fMaxError = 0.0f;
+		for (int32 k = 0; k + 1 < KeyIndices.Num(); k++)
+		{
+			const int32 first = KeyIndices[k];
+			const int32 last = KeyIndices[k + 1];
+			for (int32 i = first; i <= last; i++)
+			{
+				const float fInterpolated = FMath::Lerp(Values[first], Values[last], float(i - first) / float(last - first));
+				fMaxError = FMath::Max(fMaxError, FMath::Abs(fInterpolated - Values[i]));
+			}
+		}
+		return fMaxError;
+	}
+
+	static void MakeSignals(int32 NumSamples, TArray<TPair<FString, TArray<float>>>& OutSignals)
+	{
+		FRandomStream Random(0x1e2f);
+
+		TArray<float> Constant, Ramp, Steps, Sine, Noise;
+		for (int32 i = 0; i != NumSamples; i++)
+		{
+			const float fTime = float(i) / (NumSamples - 1);
+			Constant.Add(0.5f);
+			Ramp.Add(fTime);
+			// 8 bit DMX values snapping between cues
+			Steps.Add(float((i / 37) % 5 * 51) / 255.0f);
+			Sine.Add(FMath::Sin(fTime * 4.0f * PI));
+			Noise.Add(Random.FRand());
+		}
+
+		OutSignals.Emplace(TEXT("Constant"), Constant);
+		OutSignals.Emplace(TEXT("Ramp"), Ramp);
+		OutSignals.Emplace(TEXT("Steps"), Steps);
+		OutSignals.Emplace(TEXT("Sine"), Sine);
+		OutSignals.Emplace(TEXT("Noise"), Noise);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLexyVFXDMXReduceLinearKeysTest, "LexyVFX.DMX.SequenceBaker.ReduceLinearKeys", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FLexyVFXDMXReduceLinearKeysTest::RunTest(const FString& Parameters)
+{
+	using namespace LexyVFXDMXSequenceBakerTests;
+
+	TArray<int32> KeyIndices;
+	ULexyVFXDMXSequenceBaker::ReduceLinearKeys(TArray<float>(), 0.01f, KeyIndices);
+	TestEqual(TEXT("Keys of no samples"), KeyIndices.Num(), 0);
+
+	ULexyVFXDMXSequenceBaker::ReduceLinearKeys(TArray<float>({ 1.0f }), 0.01f, KeyIndices);
+	TestTrue(TEXT("Keys of a single sample"), KeyIndices == TArray<int32>({ 0 }));
+
+	TArray<TPair<FString, TArray<float>>> Signals;
+	MakeSignals(600, Signals);
+
+	for (const TPair<FString, TArray<float>>& Signal : Signals)
+	{
+		const TArray<float>& Values = Signal.Value;
+		for (float fTolerance : { 0.0f, 0.001f, 0.01f, 0.1f })
+		{
+			const FString Context = FString::Printf(TEXT("%s at tolerance %g"), *Signal.Key, fTolerance);
+			ULexyVFXDMXSequenceBaker::ReduceLinearKeys(Values, fTolerance, KeyIndices);
+
+			if (!TestTrue(Context + TEXT(" keeps the first and last sample"), KeyIndices.Num() >= 2 && KeyIndices[0] == 0 && KeyIndices.Last() == Values.Num() - 1))
+				continue;
+
+			bool bIncreasing = true;
+			for (int32 k = 1; k != KeyIndices.Num(); k++)
+			{
+				bIncreasing &= KeyIndices[k] > KeyIndices[k - 1];
+			}
+			TestTrue(Context + TEXT(" keys are increasing"), bIncreasing);
+
+			// Float slopes are compared, so allow for their rounding on top of the tolerance
+			const float fError = MaxInterpolationError(Values, KeyIndices);
+			TestTrue(FString::Printf(TEXT("%s error %g within tolerance"), *Context, fError), fError <= fTolerance + KINDA_SMALL_NUMBER);
+		}
+	}
+
+	// Straight lines need no keys in between
+	for (const TPair<FString, TArray<float>>& Signal : Signals)
+	{
+		if (Signal.Key == TEXT("Constant") || Signal.Key == TEXT("Ramp"))
+		{
+			ULexyVFXDMXSequenceBaker::ReduceLinearKeys(Signal.Value, 0.001f, KeyIndices);
+			TestEqual(Signal.Key + TEXT(" keys"), KeyIndices.Num(), 2);
+		}
+	}
+
+	return true;
+}
+
+#endif
@@ -18,7 +18,7 @@ struct FDMXComponentFunctions
 {
 	GENERATED_BODY()
 
-		UPROPERTY()
+		UPROPERTY(EditAnywhere, BlueprintReadWrite)
 		TArray<FName> nDMXComponentFunctions;
 };
 
@@ -37,6 +37,66 @@ enum class EDMXRotationMode : uint8
 	RotationMode_Tilt	UMETA(DisplayName = "Tilt")
 };
 
+// Decoded output of a whole fixture, written by each function component's DecodeDMX and consumed by ApplyOutput
+USTRUCT(BlueprintType)
+struct FLexyVFXDMXFixtureOutput
+{
+	GENERATED_BODY()
+
+	// Normalized 0-1
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float Dimmer = 0.0f;
+
+	// Mixed RGBW color
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FLinearColor Color = FLinearColor::White;
+
+	// Normalized 0-1, 0 being the widest beam
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float Zoom = 0.0f;
+
+	// Degrees
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float Pan = 0.0f;
+
+	// Degrees
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float Tilt = 0.0f;
+};
+
+class ULexyVFXDMXFixtureType;
+
+// Where one DMX function of the patch lives in its universe buffer
+struct FLexyVFXDMXChannelOffset
+{
+	FDMXAttributeName Attribute;
+	int32 Offset;
+	uint8 NumBytes;
+	bool bLSBMode;
+};
+
+// Decodes one function of a fixture type into the fixture output, specialized for the type's bit depth. The value
+// of the function's i-th DMX function is ChannelValues[ChannelIndices[i]].
+typedef void (*FLexyVFXDMXDecodeFunction)(const ULexyVFXDMXFixtureType& Type, const int32 *ChannelValues, const int32 *ChannelIndices, FLexyVFXDMXFixtureOutput& Output);
+
+// The curves a function component's ApplyOutput drives, written by the sequence baker. Each track evaluates the
+// baked fixture outputs through the same mapping ApplyOutput uses.
+class ILexyVFXDMXBakedTracks
+{
+public:
+	virtual ~ILexyVFXDMXBakedTracks() {}
+
+	virtual void AddFloatProperty(UActorComponent *Component, FName PropertyName, TFunctionRef<float(const FLexyVFXDMXFixtureOutput&)> Evaluate) = 0;
+
+	virtual void AddLightColor(ULightComponent *LightComponent, TFunctionRef<FLinearColor(const FLexyVFXDMXFixtureOutput&)> Evaluate) = 0;
+
+	virtual void AddMaterialScalar(UStaticMeshComponent *MeshComponent, int32 MaterialIndex, FName ParameterName, TFunctionRef<float(const FLexyVFXDMXFixtureOutput&)> Evaluate) = 0;
+
+	virtual void AddMaterialColor(UStaticMeshComponent *MeshComponent, int32 MaterialIndex, FName ParameterName, TFunctionRef<FLinearColor(const FLexyVFXDMXFixtureOutput&)> Evaluate) = 0;
+
+	virtual void AddRelativeRotation(USceneComponent *SceneComponent, TFunctionRef<FRotator(const FLexyVFXDMXFixtureOutput&)> Evaluate) = 0;
+};
+
 UCLASS( Abstract, ClassGroup = (DMXFunctions), meta = (BlueprintSpawnableComponent) )
 class LEXYVFXCPPFIXTURES_API ULexyVFXDMXBaseComponent : public UActorComponent
 {
@@ -50,7 +110,17 @@ protected:
 	// Called when the game starts
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 public:	
+	virtual void PostLoad() override;
+
+#if WITH_EDITORONLY_DATA
+	// Copies the bit depths and ranges saved on the component before fixture types existed into Type, returns false
+	// when they match Type and there is nothing to keep
+	virtual bool MigrateDeprecatedConfig(ULexyVFXDMXFixtureType& Type) const;
+#endif
+
 	// Called every frame
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
@@ -60,18 +130,73 @@ public:
 	UPROPERTY(Instanced, BlueprintReadWrite, EditAnywhere)
 		UDMXEntity *Patch;
 
-	UPROPERTY(EditAnywhere)
-		FDMXComponentFunctions FunctionNames;
+	// Shared fixture type definition. When unset, the owning function manager's type is used, then the defaults.
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+		ULexyVFXDMXFixtureType *FixtureType;
 
 	UFUNCTION()
 		virtual void SetParentDMXRef();
 
 	UFUNCTION(BlueprintCallable)
-		virtual void InitDMXFunctionNames(TArray<FName> DMXFunctionNames);
+		const ULexyVFXDMXFixtureType* GetFixtureType() const;
 
 	UFUNCTION(BlueprintCallable)
 		virtual TArray<UActorComponent*> FindComponentsByName(TSubclassOf<UActorComponent> ComponentType, TArray<FString> searchNames);
 
+	// First component FindComponentsByName finds, null when the search names match nothing
+	template<class TComponent>
+	TComponent* FindFirstComponentByName(const TArray<FString>& SearchNames)
+	{
+		const TArray<UActorComponent*> Components = this->FindComponentsByName(TComponent::StaticClass(), SearchNames);
+		return Components.Num() > 0 ? Cast<TComponent>(Components[0]) : nullptr;
+	}
+
+	// Material slot whose dynamic material instance the function components drive
+	static const int32 DynamicMaterialIndex = 0;
+
+	// The mesh's dynamic material instance, created on the first call and returned again when the mesh is bound again
+	static UMaterialInstanceDynamic* BindDynamicMaterial(UStaticMeshComponent *Mesh);
+
+	// Resolves the fixture type, decoder and scene components, on BeginPlay or later when the fixture subsystem
+	// spreads the initialization of many fixtures over frames
+	virtual void InitializeFunction();
+
+	bool bFunctionInitialized = false;
+
+	// Resolves the scene components this function drives
+	UFUNCTION(BlueprintCallable)
+		virtual void BindComponents();
+
+	// Decodes this function's DMX values into its part of the fixture output, without touching any scene component
+	void DecodeDMX(const TMap<FDMXAttributeName, int32>& DImapDMXFunctionValues, FLexyVFXDMXFixtureOutput& Output) const;
+
+	// Decodes from the owning manager's channel values, through the indices resolved by BindChannels
+	void DecodeChannels(const int32 *ChannelValues, FLexyVFXDMXFixtureOutput& Output) const;
+
+	// The DMX functions this function decodes, in the order its decoder reads them
+	virtual const TArray<FName>& GetFunctionNames(const ULexyVFXDMXFixtureType& Type) const;
+
+	// Resolves each DMX function to its index in the manager's channel offsets, once when the patch or fixture type
+	// changes. Functions the patch doesn't carry point past the last offset, at a value that's always 0.
+	void BindChannels(const TArray<FLexyVFXDMXChannelOffset>& ChannelOffsets);
+
+	TArray<int32> ChannelIndices;
+
+	// This function's decoder for the fixture type's bit depths
+	virtual FLexyVFXDMXDecodeFunction SelectDecoder(const ULexyVFXDMXFixtureType& Type) const;
+
+	// Selects the decoder once, so decoding doesn't branch on bit depth. Called again when the fixture type changes.
+	void BindDecoder();
+
+	FLexyVFXDMXDecodeFunction DecodeFunction = nullptr;
+
+	// Applies this function's part of the fixture output to the bound scene components
+	UFUNCTION(BlueprintCallable)
+		virtual void ApplyOutput(const FLexyVFXDMXFixtureOutput& Output);
+
+	// Adds a track for every value ApplyOutput drives, evaluated the way ApplyOutput evaluates it
+	virtual void DescribeBakedTracks(ILexyVFXDMXBakedTracks& Tracks) const;
+
 	UFUNCTION(BlueprintCallable)
 		virtual void UpdateDMX(TMap<FDMXAttributeName, int32> DImapDMXFunctionValues, TArray<FName> nDMXComponentFunctions);
 
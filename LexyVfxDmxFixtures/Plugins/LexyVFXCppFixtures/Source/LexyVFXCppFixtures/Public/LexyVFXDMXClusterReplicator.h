@@ -0,0 +1,122 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LexyVFXDMXBaseComponent.h"
+
+class FSocket;
+class FInternetAddr;
+class ULexyVFXDMXFixtureType;
+
+// Fixture output quantized to 16 bits per field, the unit of comparison and transport between cluster nodes.
+// Pan and tilt are quantized over the fixture type's range, so every node has to load the same fixture types.
+struct FLexyVFXDMXQuantizedOutput
+{
+	enum EField : uint8
+	{
+		Field_Dimmer,
+		Field_Red,
+		Field_Green,
+		Field_Blue,
+		Field_Zoom,
+		Field_Pan,
+		Field_Tilt,
+		Field_Count
+	};
+
+	uint16 Values[Field_Count] = {};
+
+	static FLexyVFXDMXQuantizedOutput Quantize(const FLexyVFXDMXFixtureOutput& Output, const ULexyVFXDMXFixtureType& Type);
+	FLexyVFXDMXFixtureOutput Dequantize(const ULexyVFXDMXFixtureType& Type) const;
+
+	// Bit per field that differs from Other
+	uint8 GetChangedMask(const FLexyVFXDMXQuantizedOutput& Other) const;
+};
+
+/**
+ * Sends and receives delta-encoded fixture output frames over UDP multicast.
+ *
+ * Each frame carries only the fixtures whose quantized output changed since the last frame, and only their changed
+ * fields. Every KeyframeInterval frames all fixtures are sent in full, so a secondary that joins late or drops a
+ * datagram converges on the next keyframe. Frames are split into datagrams that fit in a single Ethernet MTU.
+ */
+class LEXYVFXCPPFIXTURES_API FLexyVFXDMXClusterReplicator
+{
+public:
+	static const uint32 Magic = 0x4D44584C; // "LXDM"
+	static const uint8 Version = 2;
+	static const int32 MaxDatagramSize = 1400;
+
+	enum EFrameFlags : uint8
+	{
+		Flag_Keyframe = 1 << 0,
+		Flag_Timecode = 1 << 1
+	};
+
+	~FLexyVFXDMXClusterReplicator();
+
+	bool InitPrimary(const FString& GroupAddress, int32 Port);
+	bool InitSecondary(const FString& GroupAddress, int32 Port);
+
+	// Primary: every fixture is written each frame, unchanged ones are skipped unless the frame is a keyframe
+	void BeginFrame(uint32 FrameNumber, bool bFromTimecode, int32 KeyframeInterval);
+	void WriteFixture(uint32 FixtureId, const FLexyVFXDMXQuantizedOutput& Quantized);
+	void EndFrame();
+
+	// Secondary: queues every received frame until it is consumed
+	void ReceiveFrames();
+
+	// Secondary: applies all queued frames up to TargetFrame in order and calls ApplyFixture for every fixture they touched.
+	// With bBehindNewest, TargetFrame is the number of frames behind the newest received frame.
+	void ConsumeFrames(int64 TargetFrame, bool bBehindNewest, TFunctionRef<void(uint32 FixtureId, const FLexyVFXDMXQuantizedOutput& Quantized)> ApplyFixture);
+
+	bool IsNewestFrameFromTimecode() const { return bNewestFrameFromTimecode; }
+
+	// Datagram encoding, separate from the sockets
+	static void WriteHeader(TArray<uint8>& Datagram, uint8 Flags, uint32 FrameNumber, uint32 DatagramSequence, uint16 RecordCount);
+	static void WriteRecord(TArray<uint8>& Datagram, uint32 FixtureId, uint8 Mask, const FLexyVFXDMXQuantizedOutput& Output);
+
+	struct FRecord
+	{
+		uint32 FixtureId;
+		uint8 Mask;
+		FLexyVFXDMXQuantizedOutput Output;
+	};
+
+	static bool ParseDatagram(const TArray<uint8>& Data, uint8& OutFlags, uint32& OutFrameNumber, uint32& OutDatagramSequence, TArray<FRecord>& OutRecords);
+
+	// Stats since init
+	uint64 FramesSent = 0;
+	uint64 BytesSent = 0;
+	uint64 RecordsSent = 0;
+	uint64 FramesApplied = 0;
+	uint64 DatagramsReceived = 0;
+	uint64 DatagramsLost = 0;
+
+	// Times the primary restarted or its frame clock jumped back, and the secondary started over from its frames
+	uint64 Restarts = 0;
+
+private:
+	void FlushDatagram();
+
+	FSocket *Socket = nullptr;
+	TSharedPtr<FInternetAddr> GroupAddr;
+
+	// Primary
+	TMap<uint32, FLexyVFXDMXQuantizedOutput> SentState;
+	TArray<uint8> Datagram;
+	uint32 FrameNumber = 0;
+	uint8 FrameFlags = 0;
+	uint16 DatagramRecords = 0;
+	uint32 DatagramSequence = 0;
+	uint32 FramesSinceKeyframe = 0;
+
+	// Secondary
+	TMap<uint32, FLexyVFXDMXQuantizedOutput> ReceivedState;
+	TMap<uint32, TArray<FRecord>> PendingFrames;
+	uint32 NewestFrame = 0;
+	bool bNewestFrameFromTimecode = false;
+	bool bHasReceivedDatagram = false;
+	uint32 LastDatagramSequence = 0;
+};
@@ -0,0 +1,91 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LexyVFXDMXBaseComponent.h"
+
+// Range of a DMX parameter, and the precision it's mapped in. Floats hold every 8 and 16 bit value mapped to any
+// range exactly, 24 bit values mapped to a range like 540 degrees of pan need a double before the final rounding.
+template<EDMXParameterBitDepth BitDepth> struct TLexyVFXDMXBitDepth;
+
+template<> struct TLexyVFXDMXBitDepth<EDMXParameterBitDepth::BitDepth_8bits>
+{
+	static constexpr uint32 MaxValue = 0xFF;
+	typedef float FCalcType;
+};
+
+template<> struct TLexyVFXDMXBitDepth<EDMXParameterBitDepth::BitDepth_16bits>
+{
+	static constexpr uint32 MaxValue = 0xFFFF;
+	typedef float FCalcType;
+};
+
+template<> struct TLexyVFXDMXBitDepth<EDMXParameterBitDepth::BitDepth_24bits>
+{
+	static constexpr uint32 MaxValue = 0xFFFFFF;
+	typedef double FCalcType;
+};
+
+// Decodes a DMX value of a fixed bit depth, inlined into the function decoders specialized from it
+template<EDMXParameterBitDepth BitDepth>
+struct TLexyVFXDMXDecoder
+{
+	static constexpr uint32 MaxValue = TLexyVFXDMXBitDepth<BitDepth>::MaxValue;
+	typedef typename TLexyVFXDMXBitDepth<BitDepth>::FCalcType FCalcType;
+
+	static FORCEINLINE FCalcType NormalizeCalc(int32 Value)
+	{
+		return FCalcType(FMath::Min(uint32(FMath::Max(Value, 0)), MaxValue)) / FCalcType(MaxValue);
+	}
+
+	// 0-1
+	static FORCEINLINE float Normalize(int32 Value)
+	{
+		return float(NormalizeCalc(Value));
+	}
+
+	// RangeMin at 0, RangeMax at MaxValue
+	static FORCEINLINE float MapRange(int32 Value, float RangeMin, float RangeMax)
+	{
+		return float(FCalcType(RangeMin) + (FCalcType(RangeMax) - FCalcType(RangeMin)) * NormalizeCalc(Value));
+	}
+
+	// Range centered on 0, as used for pan and tilt
+	static FORCEINLINE float MapCentered(int32 Value, float Range)
+	{
+		return MapRange(Value, Range * -0.5f, Range * 0.5f);
+	}
+};
+
+namespace LexyVFXDMXDecoders
+{
+	// Picks the instantiation of TFunctionDecoder<BitDepth>::Decode for a bit depth, once when a component binds
+	template<template<EDMXParameterBitDepth> class TFunctionDecoder>
+	FLexyVFXDMXDecodeFunction Select(EDMXParameterBitDepth BitDepth)
+	{
+		switch (BitDepth)
+		{
+		case EDMXParameterBitDepth::BitDepth_16bits:
+			return &TFunctionDecoder<EDMXParameterBitDepth::BitDepth_16bits>::Decode;
+		case EDMXParameterBitDepth::BitDepth_24bits:
+			return &TFunctionDecoder<EDMXParameterBitDepth::BitDepth_24bits>::Decode;
+		default:
+			return &TFunctionDecoder<EDMXParameterBitDepth::BitDepth_8bits>::Decode;
+		}
+	}
+
+	// For callers that only know the bit depth per call, like the Blueprint helpers
+	inline float MapRange(EDMXParameterBitDepth BitDepth, int32 Value, float RangeMin, float RangeMax)
+	{
+		switch (BitDepth)
+		{
+		case EDMXParameterBitDepth::BitDepth_16bits:
+			return TLexyVFXDMXDecoder<EDMXParameterBitDepth::BitDepth_16bits>::MapRange(Value, RangeMin, RangeMax);
+		case EDMXParameterBitDepth::BitDepth_24bits:
+			return TLexyVFXDMXDecoder<EDMXParameterBitDepth::BitDepth_24bits>::MapRange(Value, RangeMin, RangeMax);
+		default:
+			return TLexyVFXDMXDecoder<EDMXParameterBitDepth::BitDepth_8bits>::MapRange(Value, RangeMin, RangeMax);
+		}
+	}
+}
@@ -14,10 +14,16 @@ class LEXYVFXCPPFIXTURES_API ULexyVFXDMXDimmerComponent : public ULexyVFXDMXBase
 {
 	GENERATED_BODY()
 	
-protected:
-	void BeginPlay() override;
 public:
-	void UpdateDMX(TMap<FDMXAttributeName, int32> DImapDMXFunctionValues, TArray<FName> nDMXComponentFunctions) override;
+	void BindComponents() override;
+
+	FLexyVFXDMXDecodeFunction SelectDecoder(const ULexyVFXDMXFixtureType& Type) const override;
+
+	const TArray<FName>& GetFunctionNames(const ULexyVFXDMXFixtureType& Type) const override;
+
+	void ApplyOutput(const FLexyVFXDMXFixtureOutput& Output) override;
+
+	void DescribeBakedTracks(ILexyVFXDMXBakedTracks& Tracks) const override;
 
 	UPROPERTY(EditAnywhere)
 	UStaticMeshComponent *SMRef_Beam;
@@ -34,9 +40,14 @@ public:
 	UPROPERTY(EditAnywhere)
 	UMaterialInstanceDynamic *miLens;
 
-	UPROPERTY(EditAnywhere)
-	EDMXParameterBitDepth dimmerBitDepth;
+#if WITH_EDITORONLY_DATA
+	bool MigrateDeprecatedConfig(ULexyVFXDMXFixtureType& Type) const override;
 
-	UPROPERTY(EditAnywhere)
-	float fLightIntensity = 60000.0f;
+	// Moved to ULexyVFXDMXFixtureType, only loaded to migrate Blueprints saved before it
+	UPROPERTY()
+	EDMXParameterBitDepth dimmerBitDepth_DEPRECATED = EDMXParameterBitDepth::BitDepth_8bits;
+
+	UPROPERTY()
+	float fLightIntensity_DEPRECATED = 60000.0f;
+#endif
 };
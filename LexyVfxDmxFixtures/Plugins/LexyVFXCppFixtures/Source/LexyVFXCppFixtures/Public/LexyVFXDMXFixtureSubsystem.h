@@ -0,0 +1,328 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "DMXProtocol/Public/DMXProtocolTypes.h"
+#include "LexyVFXDMXClusterReplicator.h"
+#include "LexyVFXDMXJitterBuffer.h"
+#include "LexyVFXDMXMergeEngine.h"
+#include "LexyVFXDMXMotionSmoother.h"
+#include "LexyVFXDMXNetworkReceiver.h"
+#include "LexyVFXDMXSharedMemoryReader.h"
+#include "LexyVFXDMXFixtureSubsystem.generated.h"
+
+class ULexyVFXDMXFunctionManager;
+class ULexyVFXDMXFixtureType;
+class UDMXEntityFixturePatch;
+class UDMXLibrary;
+
+DECLARE_DYNAMIC_DELEGATE_ThreeParams(FDMXReceivedDelegate, FDMXProtocolName, Protocol, int32, Universe, const TArray<uint8>&, DMXBuffer);
+
+UENUM(BlueprintType)
+enum class ELexyVFXDMXClusterRole : uint8
+{
+	ClusterRole_Standalone	UMETA(DisplayName = "Standalone"),
+	ClusterRole_Primary		UMETA(DisplayName = "Primary"),
+	ClusterRole_Secondary	UMETA(DisplayName = "Secondary")
+};
+
+// Master values shared by every fixture in a group and its child groups
+USTRUCT(BlueprintType)
+struct FLexyVFXDMXFixtureGroup
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FName Name;
+
+	// Group whose masters are applied on top of this one, a root group every other group parents to acts as grand master
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FName ParentGroup;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float Dimmer = 1.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FLinearColor Color = FLinearColor::White;
+
+	// When set, the master dimmer follows this 8 bit channel, like a submaster on the console
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 DimmerUniverse = INDEX_NONE;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 DimmerChannel = 1;
+};
+
+/**
+ * Central DMX dispatch for all fixtures in a world. Receives DMX once, marks the fixtures patched on the received
+ * universe dirty and evaluates them in one batched pass per frame.
+ *
+ * A universe received from several sources is merged HTP or LTP between its highest priority sources first, only
+ * frames that change the merged universe reach the fixtures. The DMX subsystem only tells protocols apart, each is one
+ * source. With LexyVFX.DMX.Merge.ReceiveSenders set, Art-Net and sACN are received on sockets of the subsystem's own
+ * instead, each Art-Net node and sACN source is a source of its own, at the priority it sends for sACN. Universes can
+ * also be read from a local console process through a shared-memory ring named by LexyVFX.DMX.SharedMemory.Name.
+ *
+ * Fixtures decode straight from the last received buffer of their universe through channel offsets built when they
+ * are bound. A patch, fixture type or library edit only rebinds the fixtures it affects, queued and spread over frames.
+ *
+ * Group masters are resolved once per group down the group hierarchy, then combined with each fixture's decoded
+ * output. A master change marks only that group's fixtures dirty, without decoding their channels again.
+ *
+ * With LexyVFX.DMX.JitterBuffer.Delay set, received universes are held for a fixed delay, aligned to engine timecode
+ * when a timecode provider is set, before they reach the fixtures.
+ *
+ * A fixture whose level streams out leaves only its quantized output behind, keyed by its fixture id, and costs no
+ * evaluation until it streams back in. It then initializes as soon as its last fixture component begins play,
+ * regardless of the initialization budget below, with that output applied, and picks up the latest DMX received for
+ * its universe.
+ *
+ * With LexyVFX.DMX.MaxInitializationsPerFrame set, fixtures beginning play queue their binding here and are
+ * initialized a fixed number per frame, also while the world is paused, so loading or spawning a large rig doesn't
+ * hitch. It is off by default: a deferred fixture's components and material instances are only bound after its
+ * BeginPlay, so Blueprint subclasses can't use them there. Function components of the same actor class resolve
+ * their scene components from the names the first fixture of that class found.
+ *
+ * Fixture types with bSmoothMotion don't jump to new pan, tilt and zoom values: the subsystem moves them there at
+ * render rate through a speed and acceleration limited motor model, stepping every moving fixture in one pass.
+ *
+ * In a cluster, the primary node evaluates the rig and broadcasts the fixture outputs; secondary nodes don't
+ * receive DMX at all and apply the primary's frames instead. The role is set with LexyVFX.DMX.Cluster.Role.
+ */
+UCLASS()
+class LEXYVFXCPPFIXTURES_API ULexyVFXDMXFixtureSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	ULexyVFXDMXFixtureSubsystem();
+	virtual ~ULexyVFXDMXFixtureSubsystem();
+
+	static ULexyVFXDMXFixtureSubsystem* Get(const UObject *WorldContextObject);
+
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual bool IsTickableWhenPaused() const override;
+	virtual TStatId GetStatId() const override;
+
+	void RegisterFixture(ULexyVFXDMXFunctionManager *Fixture);
+	void UnregisterFixture(ULexyVFXDMXFunctionManager *Fixture);
+
+	// Unregisters a fixture whose level streamed out, keeping its output to restore when it streams back in
+	void UnloadFixture(ULexyVFXDMXFunctionManager *Fixture);
+	void MarkFixtureDirty(ULexyVFXDMXFunctionManager *Fixture);
+
+	// Queues the initialization of Actor's fixture when it is spread over frames, returns false when the caller should initialize now
+	bool DeferInitialization(AActor *Actor);
+
+	// Names of the components a function component's search found on the first fixture of ActorClass
+	const TArray<FName>* FindComponentBinding(UClass *ActorClass, TSubclassOf<UActorComponent> ComponentType, const TArray<FString>& SearchNames) const;
+	void AddComponentBinding(UClass *ActorClass, TSubclassOf<UActorComponent> ComponentType, const TArray<FString>& SearchNames, const TArray<UActorComponent*>& Components);
+
+	// Queues the fixture to rebuild its channel offsets and universe routing on the next tick
+	void RequestRebind(ULexyVFXDMXFunctionManager *Fixture);
+
+	// Rebinds every fixture using Patch, call after changing a patch at runtime
+	UFUNCTION(BlueprintCallable, Category = "DMX")
+	void NotifyPatchChanged(UDMXEntityFixturePatch *Patch);
+
+	void RequestRebindAll();
+
+	// Adds or updates a group, its fixtures pick up the new masters on the next tick
+	UFUNCTION(BlueprintCallable, Category = "DMX")
+	void SetGroup(const FLexyVFXDMXFixtureGroup& Group);
+
+	UFUNCTION(BlueprintCallable, Category = "DMX")
+	void SetGroupDimmer(FName Group, float Dimmer);
+
+	UFUNCTION(BlueprintCallable, Category = "DMX")
+	void SetGroupColor(FName Group, FLinearColor Color);
+
+	UFUNCTION(BlueprintCallable, Category = "DMX")
+	void SetFixtureGroup(ULexyVFXDMXFunctionManager *Fixture, FName Group);
+
+	UFUNCTION(BlueprintCallable, Category = "DMX")
+	FLexyVFXDMXJitterStats GetJitterStats() const;
+
+	UFUNCTION(BlueprintCallable, Category = "DMX")
+	void ResetJitterStats();
+
+	void LogJitterStats() const;
+
+	// Fixture output with the resolved masters of its group applied
+	FLexyVFXDMXFixtureOutput CombineGroupMasters(const ULexyVFXDMXFunctionManager *Fixture, const FLexyVFXDMXFixtureOutput& DecodedOutput) const;
+
+	UFUNCTION()
+	void ProcessDMX(FDMXProtocolName Protocol, int32 Universe, const TArray<uint8>& DMXBuffer);
+
+	// Receives a universe frame from a named merge source
+	UFUNCTION(BlueprintCallable, Category = "DMX")
+	void ProcessSourceDMX(FName Source, int32 Universe, const TArray<uint8>& DMXBuffer);
+
+	// Only the highest priority sources sending a universe are merged, 100 by default as in sACN. sACN sources
+	// received per sender set their own priority with every packet.
+	UFUNCTION(BlueprintCallable, Category = "DMX")
+	void SetSourcePriority(FName Source, int32 Priority);
+
+	UFUNCTION(BlueprintCallable, Category = "DMX")
+	void SetUniverseMergeMode(int32 Universe, ELexyVFXDMXMergeMode Mode);
+
+	void LogMergeSources() const;
+
+	void LogSharedMemoryStats() const;
+
+	const TArray<ULexyVFXDMXFunctionManager*>& GetFixtures() const { return Fixtures; }
+
+	ELexyVFXDMXClusterRole GetClusterRole() const { return ClusterRole; }
+
+	void LogClusterStats() const;
+
+private:
+	void SetReceivingDMX(bool bReceive);
+
+	// Stops receiving and closes the network, cluster and shared memory sockets once the last fixture is gone
+	void StopReceivers();
+	void ReceiveSourceDMX(FName Source, int32 Universe, TArrayView<const uint8> DMXBuffer);
+	void ReceiveUniverse(int32 Universe, const TArray<uint8>& DMXBuffer);
+	void PollSharedMemory();
+	void PollNetwork();
+	void ApplyUniverse(int32 Universe, const TArray<uint8>& DMXBuffer);
+	void ReleaseJitterBuffer();
+
+	// Engine timecode in seconds when aligning to it, otherwise platform time
+	double GetJitterClock() const;
+	void RouteFixture(ULexyVFXDMXFunctionManager *Fixture);
+	void UnrouteFixture(ULexyVFXDMXFunctionManager *Fixture);
+	void ProcessPendingRebinds();
+	void ProcessPendingInitializations();
+	void InitializeActor(AActor *Actor);
+	int32 FindOrAddGroup(FName Group);
+	void MarkGroupDirty(int32 GroupIndex);
+	void ResolveGroupMasters();
+	void ProcessGroupMasters(int32 Universe, const TArray<uint8>& DMXBuffer);
+	void WatchLibrary(UDMXLibrary *Library);
+	void OnLibraryEntitiesUpdated(UDMXLibrary *Library);
+#if WITH_EDITOR
+	void OnObjectPropertyChanged(UObject *Object, FPropertyChangedEvent& PropertyChangedEvent);
+#endif
+	void SetClusterRole(ELexyVFXDMXClusterRole NewRole);
+	void EvaluateDirtyFixtures();
+
+	// Moves the fixture's pan, tilt and zoom towards Output instead of applying it directly
+	void SetMotionTarget(ULexyVFXDMXFunctionManager *Fixture, const FLexyVFXDMXFixtureOutput& Output);
+	void RemoveMotion(ULexyVFXDMXFunctionManager *Fixture);
+	void UpdateMotion(float DeltaTime);
+
+	// Applies every moving fixture's target immediately
+	void SettleMotion();
+	void SendClusterFrame();
+	void ApplyClusterFrames();
+
+	// Timecode frame when a timecode provider is set, so every node agrees on it, otherwise the primary's update count
+	uint32 GetClusterFrameNumber(bool& bOutFromTimecode) const;
+
+	UPROPERTY()
+	TArray<ULexyVFXDMXFunctionManager*> Fixtures;
+
+	UPROPERTY()
+	TArray<ULexyVFXDMXFunctionManager*> DirtyFixtures;
+
+	TMap<int32, TArray<ULexyVFXDMXFunctionManager*>> UniverseFixtures;
+
+	// Patches are weak, a patch removed from its library may be collected while fixtures are still routed under it
+	TMap<TWeakObjectPtr<UDMXEntityFixturePatch>, TArray<ULexyVFXDMXFunctionManager*>> PatchFixtures;
+
+	// Fixtures are routed under the universe and patch they were bound with, which may since have changed
+	TMap<ULexyVFXDMXFunctionManager*, TWeakObjectPtr<UDMXEntityFixturePatch>> RoutedPatches;
+
+	UPROPERTY()
+	TArray<ULexyVFXDMXFunctionManager*> PendingRebinds;
+
+	TArray<TWeakObjectPtr<AActor>> PendingInitializations;
+
+	TSet<TWeakObjectPtr<AActor>> DeferredActors;
+
+	struct FComponentBinding
+	{
+		TWeakObjectPtr<UClass> ActorClass;
+		TWeakObjectPtr<UClass> ComponentType;
+		TArray<FString> SearchNames;
+		TArray<FName> ComponentNames;
+	};
+
+	TMap<uint32, FComponentBinding> ComponentBindings;
+
+	// Last buffer received per universe
+	TMap<int32, TArray<uint8>> UniverseBuffers;
+
+	FLexyVFXDMXMergeEngine MergeEngine;
+
+	FLexyVFXDMXJitterBuffer JitterBuffer;
+
+	FLexyVFXDMXMotionSmoother MotionSmoother;
+
+	// Fixture of each motion smoother slot
+	UPROPERTY()
+	TArray<ULexyVFXDMXFunctionManager*> MotionFixtures;
+
+	TUniquePtr<FLexyVFXDMXSharedMemoryReader> SharedMemoryReader;
+
+	// Only while LexyVFX.DMX.Merge.ReceiveSenders is set, kept after failing to open so it isn't retried every frame
+	TUniquePtr<FLexyVFXDMXNetworkReceiver> NetworkReceiver;
+
+	double NextSharedMemoryOpenTime = 0.0;
+	double LastSharedMemoryFrameTime = 0.0;
+	bool bSharedMemoryOpenFailed = false;
+
+	TMap<TWeakObjectPtr<UDMXLibrary>, FDelegateHandle> WatchedLibraries;
+
+#if WITH_EDITOR
+	FDelegateHandle ObjectPropertyChangedHandle;
+#endif
+
+	TMap<uint32, ULexyVFXDMXFunctionManager*> FixturesById;
+
+	// Last output of fixtures whose level streamed out, by fixture id
+	TMap<uint32, FLexyVFXDMXQuantizedOutput> UnloadedOutputs;
+
+	FDMXReceivedDelegate ReceivedDMX;
+
+	bool bReceivingDMX = false;
+
+	// The last fixture unregistered, receivers stop on the next tick unless a fixture registers before it
+	bool bStopReceiversPending = false;
+
+	ELexyVFXDMXClusterRole ClusterRole = ELexyVFXDMXClusterRole::ClusterRole_Standalone;
+
+	// Last role set through LexyVFX.DMX.Cluster.Role, ClusterRole falls back to standalone if its socket can't be opened
+	ELexyVFXDMXClusterRole RequestedClusterRole = ELexyVFXDMXClusterRole::ClusterRole_Standalone;
+
+	TUniquePtr<FLexyVFXDMXClusterReplicator> ClusterReplicator;
+
+	struct FGroupState
+	{
+		FLexyVFXDMXFixtureGroup Group;
+		int32 ParentIndex = INDEX_NONE;
+		TArray<int32> ChildIndices;
+		TArray<ULexyVFXDMXFunctionManager*> GroupFixtures;
+
+		// Product of this group's and all its parents' masters
+		float ResolvedDimmer = 1.0f;
+		FLinearColor ResolvedColor = FLinearColor::White;
+		bool bResolveDirty = true;
+	};
+
+	// Groups are only ever added, fixtures keep their index into this array
+	TArray<FGroupState> Groups;
+
+	TMap<FName, int32> GroupIndices;
+
+	bool bGroupsDirty = false;
+
+	uint32 UpdateCount = 0;
+};
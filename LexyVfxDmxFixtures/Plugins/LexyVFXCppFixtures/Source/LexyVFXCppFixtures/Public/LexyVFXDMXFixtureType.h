@@ -0,0 +1,128 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "LexyVFXDMXBaseComponent.h"
+#include "LexyVFXDMXFixtureType.generated.h"
+
+/**
+ * Shared, read-only definition of a fixture type. Every fixture of the same type references one of these
+ * instead of carrying its own copy of bit depths, ranges, DMX function names and component search names.
+ * Fixtures without a type assigned fall back to the class default object, which holds the original defaults.
+ */
+UCLASS( BlueprintType )
+class LEXYVFXCPPFIXTURES_API ULexyVFXDMXFixtureType : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	ULexyVFXDMXFixtureType();
+
+	static const ULexyVFXDMXFixtureType* GetDefaultType();
+
+	// Bytes held by this definition, including heap allocations of its arrays and strings
+	SIZE_T GetSharedConfigBytes() const;
+
+	float GetLightIntensity(float Dimmer) const { return Dimmer * fLightIntensity; }
+
+	float GetBeamAngle(float Zoom) const { return FMath::Lerp(fBeamRangeMax, fBeamRangeMin, Zoom); }
+
+	float GetSpringArmLength(float Zoom) const { return Zoom * fBeamRangeLinear; }
+
+	// Pan, tilt and zoom lanes of the motion smoother, an axis without a max speed isn't smoothed
+	FVector4 GetMotionMaxSpeeds() const;
+	FVector4 GetMotionMaxAccelerations() const;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Dimmer")
+	EDMXParameterBitDepth dimmerBitDepth;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Dimmer")
+	float fLightIntensity = 60000.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Dimmer")
+	FDMXComponentFunctions DimmerFunctionNames;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Color Mix RGBW")
+	EDMXParameterBitDepth colorMixRGBWBitDepth;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Color Mix RGBW")
+	FDMXComponentFunctions ColorMixRGBWFunctionNames;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Pan")
+	EDMXParameterBitDepth panBitDepth;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Pan")
+	float fPanRange = 540.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Pan")
+	FDMXComponentFunctions PanFunctionNames;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Tilt")
+	EDMXParameterBitDepth tiltBitDepth;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Tilt")
+	float fTiltRange = 250.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Tilt")
+	FDMXComponentFunctions TiltFunctionNames;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Zoom")
+	EDMXParameterBitDepth zoomBitDepth;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Zoom")
+	float fBeamRangeLinear = 4.69101f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Zoom")
+	float fBeamRangeMin = 3.7f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Zoom")
+	float fBeamRangeMax = 35.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Zoom")
+	FDMXComponentFunctions ZoomFunctionNames;
+
+	// Moves pan, tilt and zoom towards their DMX values at render rate, limited by the speeds and accelerations below
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Motion")
+	bool bSmoothMotion = false;
+
+	// Degrees per second
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Motion")
+	float fPanMaxSpeed = 240.0f;
+
+	// Degrees per second squared
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Motion")
+	float fPanMaxAcceleration = 960.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Motion")
+	float fTiltMaxSpeed = 200.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Motion")
+	float fTiltMaxAcceleration = 800.0f;
+
+	// Full zoom range per second
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Motion")
+	float fZoomMaxSpeed = 1.5f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Motion")
+	float fZoomMaxAcceleration = 6.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Component Search Names")
+	TArray<FString> SpotSearchNames;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Component Search Names")
+	TArray<FString> BeamSearchNames;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Component Search Names")
+	TArray<FString> LensSearchNames;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Component Search Names")
+	TArray<FString> YokeSearchNames;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Component Search Names")
+	TArray<FString> HeadSearchNames;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Component Search Names")
+	TArray<FString> SpringArmSearchNames;
+};
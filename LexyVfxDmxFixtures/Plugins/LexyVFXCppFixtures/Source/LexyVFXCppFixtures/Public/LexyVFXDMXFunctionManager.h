@@ -12,7 +12,7 @@
 #include "DMXProtocol/Public/DMXProtocolTypes.h"
 #include "LexyVFXDMXFunctionManager.generated.h"
 
-DECLARE_DYNAMIC_DELEGATE_ThreeParams(FDMXReceivedDelegate, FDMXProtocolName, Protocol, int32, Universe, const TArray<uint8>&, DMXBuffer);
+class ULexyVFXDMXFixtureType;
 
 UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
 class LEXYVFXCPPFIXTURES_API ULexyVFXDMXFunctionManager : public UActorComponent
@@ -27,12 +27,12 @@ protected:
 	// Called when the game starts
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 public:	
 	// Called every frame
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
-	FDMXReceivedDelegate ReceivedDMX;
-
 	UPROPERTY(Instanced, BlueprintReadWrite, EditAnywhere)
 	UDMXComponent *DMXComp;
 
@@ -42,12 +42,88 @@ public:
 	UPROPERTY(Instanced, BlueprintReadWrite, EditAnywhere)
 	TArray<ULexyVFXDMXBaseComponent*> LexyVFXFunctionComponents;
 
+	// Shared fixture type definition used by every function component on this fixture that doesn't set its own
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	ULexyVFXDMXFixtureType *FixtureType;
+
+	UFUNCTION(BlueprintCallable)
+	const ULexyVFXDMXFixtureType* GetFixtureType() const;
+
+	// Fixture group whose masters scale this fixture's output, see ULexyVFXDMXFixtureSubsystem::SetGroup
+	UPROPERTY(BlueprintReadOnly, EditAnywhere)
+	FName Group;
+
+	// Output decoded from this fixture's own channels, before group masters
+	UPROPERTY(BlueprintReadOnly)
+	FLexyVFXDMXFixtureOutput DecodedOutput;
+
+	// Last applied output of this fixture
+	UPROPERTY(BlueprintReadOnly)
+	FLexyVFXDMXFixtureOutput Output;
+
+	void DecodeDMX(const TMap<FDMXAttributeName, int32>& DImapDMXFunctionValues, FLexyVFXDMXFixtureOutput& OutOutput) const;
+
+	UFUNCTION(BlueprintCallable)
+	void ApplyOutput(const FLexyVFXDMXFixtureOutput& InOutput);
+
+	// Binds the DMX component, function components and patch and registers with the fixture subsystem, on BeginPlay
+	// or later when the fixture subsystem spreads the initialization of many fixtures over frames
+	void InitializeFixture();
+
+	bool bFixtureInitialized = false;
+
 	UFUNCTION()
 	virtual void SetParentDMXRef();
 
 	UFUNCTION()
 	void SetFunctionComponentReferences();
 
+	void AddFunctionComponent(ULexyVFXDMXBaseComponent *FunctionComponent);
+
+	void RemoveFunctionComponent(ULexyVFXDMXBaseComponent *FunctionComponent);
+
+	// Picks up a patch swapped on the DMX component, without rescanning the actor
+	void RefreshPatch();
+
+	// Rebuilds the universe and channel offsets of the patch's functions
+	void BuildChannelOffsets();
+
+	// Sizes ChannelValues and points each function component at its channels
+	void BindFunctionChannels();
+
+	// Changes whenever anything the channel offsets were built from changes
+	uint32 GetBindingSignature() const;
+
 	UFUNCTION()
 	void ProcessDMX(FDMXProtocolName Protocol, int32 Universe, const TArray<uint8>& DMXBuffer);
+
+	// Decodes the patch's functions from its universe buffer into DecodedOutput
+	void DecodeUniverse(const TArray<uint8>& DMXBuffer);
+
+	// Decodes and applies without group masters
+	void EvaluateDMX(const TArray<uint8>& DMXBuffer);
+
+	int32 BoundUniverse = INDEX_NONE;
+
+	uint32 BindingSignature = 0;
+
+	TArray<FLexyVFXDMXChannelOffset> ChannelOffsets;
+
+	// Decoded value of each channel offset, reused by every decode. One extra 0 at the end for missing functions.
+	TArray<int32> ChannelValues;
+
+	// Stable across processes loading the same level, used to address this fixture in cluster frames
+	uint32 FixtureId = 0;
+
+	int32 GroupIndex = INDEX_NONE;
+
+	// Slot in the subsystem's motion smoother while pan, tilt or zoom is still moving towards MotionTarget
+	int32 MotionIndex = INDEX_NONE;
+
+	FLexyVFXDMXFixtureOutput MotionTarget;
+
+	bool bDMXDirty = false;
+
+	// Cleared when only a group master changed and the fixture's own channels don't need decoding again
+	bool bDecodeDirty = false;
 };
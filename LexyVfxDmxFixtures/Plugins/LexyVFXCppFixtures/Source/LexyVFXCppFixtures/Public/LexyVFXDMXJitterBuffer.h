@@ -0,0 +1,109 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LexyVFXDMXJitterBuffer.generated.h"
+
+USTRUCT(BlueprintType)
+struct FLexyVFXDMXJitterStats
+{
+	GENERATED_BODY()
+
+	// Fixed delay frames are held for before they are applied
+	UPROPERTY(BlueprintReadOnly)
+	float DelayMs = 0.0f;
+
+	// Mean time between frames of a source's universe, and its mean deviation, averaged over universes
+	UPROPERTY(BlueprintReadOnly)
+	float IntervalMs = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly)
+	float JitterMs = 0.0f;
+
+	// Largest deviation seen on any universe, frames arriving later than the delay allows for are applied late
+	UPROPERTY(BlueprintReadOnly)
+	float MaxJitterMs = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 BufferDepth = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 MaxBufferDepth = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	int64 FramesReleased = 0;
+
+	// Frames dropped because their universe's buffer was full
+	UPROPERTY(BlueprintReadOnly)
+	int64 FramesDropped = 0;
+};
+
+/**
+ * Holds received universe frames for a fixed delay before they are applied, so DMX lines up with video sources that
+ * arrive with a different latency, and arrival jitter doesn't show up as judder.
+ *
+ * Frames are stamped on receipt with the caller's clock, engine timecode when aligning to it, and released in order
+ * once the clock has moved past their stamp plus the delay. Each universe holds its frames in its own ring, capped at
+ * MaxFramesPerUniverse, so a busy rig can't push another universe's frames out before they are due.
+ */
+class LEXYVFXCPPFIXTURES_API FLexyVFXDMXJitterBuffer
+{
+public:
+	void Push(int32 Universe, const TArray<uint8>& DMXBuffer, double Timestamp);
+
+	// Updates the jitter estimate of a source's universe, called for every received frame whether it is held or not
+	void RecordArrival(FName Source, int32 Universe, double ArrivalSeconds);
+
+	// Releases every frame stamped at or before ReleaseTime, oldest first
+	void Release(double ReleaseTime, TFunctionRef<void(int32 Universe, const TArray<uint8>& DMXBuffer)> ApplyUniverse);
+
+	void Flush(TFunctionRef<void(int32 Universe, const TArray<uint8>& DMXBuffer)> ApplyUniverse);
+
+	bool IsEmpty() const { return NumFrames == 0; }
+
+	int32 MaxFramesPerUniverse = 256;
+
+	FLexyVFXDMXJitterStats GetStats(float DelayMs) const;
+
+	void ResetStats();
+
+private:
+	struct FFrame
+	{
+		double Timestamp = 0.0;
+		TArray<uint8> Buffer;
+	};
+
+	struct FUniverseTiming
+	{
+		double LastArrival = 0.0;
+		double Interval = 0.0;
+		double Jitter = 0.0;
+		double MaxJitter = 0.0;
+		int32 NumArrivals = 0;
+	};
+
+	// Ring of a universe's held frames, oldest at Head. Slots keep their buffers, so receiving doesn't allocate.
+	struct FUniverseFrames
+	{
+		TArray<FFrame> Ring;
+		int32 Head = 0;
+		int32 Num = 0;
+		bool bDropWarned = false;
+	};
+
+	// Releases the universe's frames stamped at or before ReleaseTime, stamps only ever increase unless the clock jumps
+	void ReleaseFrames(int32 Universe, FUniverseFrames& UniverseFrames, double ReleaseTime, TFunctionRef<void(int32 Universe, const TArray<uint8>& DMXBuffer)> ApplyUniverse);
+
+	TMap<int32, FUniverseFrames> Frames;
+
+	int32 NumFrames = 0;
+
+	TMap<TPair<FName, int32>, FUniverseTiming> UniverseTimings;
+
+	double LastReleaseTime = 0.0;
+	int32 MaxBufferDepth = 0;
+	int64 FramesReleased = 0;
+	int64 FramesDropped = 0;
+};
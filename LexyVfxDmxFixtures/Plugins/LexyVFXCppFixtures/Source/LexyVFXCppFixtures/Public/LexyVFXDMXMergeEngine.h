@@ -0,0 +1,80 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LexyVFXDMXMergeEngine.generated.h"
+
+UENUM(BlueprintType)
+enum class ELexyVFXDMXMergeMode : uint8
+{
+	// Highest value of all sources wins
+	MergeMode_HTP	UMETA(DisplayName = "HTP"),
+	// Source that last changed a channel wins it
+	MergeMode_LTP	UMETA(DisplayName = "LTP")
+};
+
+/**
+ * Merges the same universe received from several sources into one effective universe, ahead of fixture dispatch.
+ *
+ * As in sACN, only the sources with the highest priority on a universe take part in its merge, and a source that
+ * stops sending drops out once it times out. Between them channels are merged HTP, with a vectorized byte max, or
+ * LTP, with a timestamp per channel of each source.
+ */
+class LEXYVFXCPPFIXTURES_API FLexyVFXDMXMergeEngine
+{
+public:
+	static const int32 UniverseSize = 512;
+	static const int32 DefaultPriority = 100;
+
+	// Returns the merged universe when the frame changed it, otherwise null
+	const TArray<uint8>* Receive(FName Source, int32 Universe, TArrayView<const uint8> DMXBuffer, double Now);
+
+	// Drops sources that timed out and merges universes whose priorities or modes changed again
+	void Update(double Now, TFunctionRef<void(int32 Universe, const TArray<uint8>& DMXBuffer)> ApplyUniverse);
+
+	void SetSourcePriority(FName Source, int32 Priority);
+	void SetUniverseMergeMode(int32 Universe, ELexyVFXDMXMergeMode Mode);
+
+	void LogSources() const;
+
+	ELexyVFXDMXMergeMode DefaultMode = ELexyVFXDMXMergeMode::MergeMode_HTP;
+
+	double SourceTimeout = 2.5;
+
+	// Dest[i] = max(Dest[i], Source[i])
+	static void MaxBytes(uint8 *Dest, const uint8 *Source, int32 Num);
+
+private:
+	struct FUniverseSource
+	{
+		int32 SourceIndex;
+		double LastReceived;
+		TArray<uint8> Buffer;
+		TArray<uint32> ChannelStamps;
+	};
+
+	struct FUniverse
+	{
+		TArray<FUniverseSource> Sources;
+		TArray<uint8> Merged;
+		TOptional<ELexyVFXDMXMergeMode> Mode;
+	};
+
+	int32 FindOrAddSource(FName Source);
+
+	// Returns true when the merged universe changed
+	bool Merge(FUniverse& Universe);
+
+	TArray<FName> SourceNames;
+	TArray<int32> SourcePriorities;
+	TMap<FName, int32> SourceIndices;
+
+	TMap<int32, FUniverse> Universes;
+	TSet<int32> DirtyUniverses;
+
+	TArray<uint8> MergeScratch;
+
+	// Increases with every received frame, the LTP timestamp of the channels it changed
+	uint32 FrameStamp = 0;
+};
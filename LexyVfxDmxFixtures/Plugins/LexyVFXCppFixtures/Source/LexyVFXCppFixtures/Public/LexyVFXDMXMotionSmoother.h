@@ -0,0 +1,48 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Moves fixture axes towards their DMX targets the way a fixture's motors would: velocity limited to a max speed,
+ * changed by at most a max acceleration, and braked early enough to stop on the target without overshooting.
+ *
+ * Each slot is one fixture, its pan, tilt and zoom packed into the lanes of a single vector so one step of the motor
+ * model runs for all three axes at once. Slots are stored as separate arrays per quantity and stepped in one pass.
+ */
+class LEXYVFXCPPFIXTURES_API FLexyVFXDMXMotionSmoother
+{
+public:
+	enum EAxis
+	{
+		Axis_Pan,
+		Axis_Tilt,
+		Axis_Zoom
+	};
+
+	int32 AddSlot(const FVector4& Position);
+
+	// Moves the last slot into Slot, as RemoveAtSwap
+	void RemoveSlot(int32 Slot);
+
+	void Reset();
+
+	int32 Num() const { return Positions.Num(); }
+
+	void SetTarget(int32 Slot, const FVector4& Target, const FVector4& MaxSpeed, const FVector4& MaxAcceleration);
+
+	const FVector4& GetPosition(int32 Slot) const { return Positions[Slot]; }
+
+	// Every axis is on its target and stopped
+	bool IsSettled(int32 Slot) const;
+
+	void Step(float DeltaTime);
+
+private:
+	TArray<FVector4> Positions;
+	TArray<FVector4> Velocities;
+	TArray<FVector4> Targets;
+	TArray<FVector4> MaxSpeeds;
+	TArray<FVector4> MaxAccelerations;
+};
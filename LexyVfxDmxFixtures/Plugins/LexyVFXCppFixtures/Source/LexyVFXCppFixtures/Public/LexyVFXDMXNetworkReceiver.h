@@ -0,0 +1,60 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FSocket;
+
+/**
+ * Receives Art-Net and sACN on sockets of its own, so every sender is a merge source of its own: an Art-Net node by
+ * its IP address, an sACN source by its CID, with the priority it sends. The DMX subsystem only reports which protocol
+ * a universe came from, two consoles sending the same universe can't be told apart through it.
+ *
+ * Only ArtDmx and E1.31 data packets with the null start code are read, sACN preview data is ignored. Universes are
+ * the Art-Net port address and the sACN universe, as a patch's remote universe. The sockets are opened reusable next to
+ * the DMX plugin's, but a unicast datagram only reaches one of them, so the DMX plugin's input should be disabled when
+ * senders unicast.
+ */
+class LEXYVFXCPPFIXTURES_API FLexyVFXDMXNetworkReceiver
+{
+public:
+	static const int32 ArtNetPort = 6454;
+	static const int32 SACNPort = 5568;
+
+	~FLexyVFXDMXNetworkReceiver();
+
+	// True when either protocol's socket opened
+	bool Open();
+	void Close();
+	bool IsOpen() const { return ArtNetSocket != nullptr || SACNSocket != nullptr; }
+
+	// sACN is multicast per universe, a universe's group is joined once the first fixture is patched on it
+	void JoinSACNUniverse(int32 Universe);
+
+	// Hands every packet received since the last poll to ReadPacket, with the sACN priority or INDEX_NONE for Art-Net.
+	// Returns the number of packets read. The view is only valid during the call.
+	int32 Poll(TFunctionRef<void(FName Source, int32 Priority, int32 Universe, TArrayView<const uint8> DMXBuffer)> ReadPacket);
+
+	// Packet parsing, separate from the sockets
+	static bool ParseArtDmx(TArrayView<const uint8> Data, int32& OutUniverse, TArrayView<const uint8>& OutDMXBuffer);
+	static bool ParseSACN(TArrayView<const uint8> Data, FGuid& OutCID, int32& OutPriority, int32& OutUniverse, TArrayView<const uint8>& OutDMXBuffer);
+
+	// Stats since open
+	uint64 PacketsRead = 0;
+	uint64 PacketsIgnored = 0;
+
+private:
+	int32 PollSocket(FSocket *Socket, bool bSACN, TFunctionRef<void(FName Source, int32 Priority, int32 Universe, TArrayView<const uint8> DMXBuffer)> ReadPacket);
+
+	FSocket *ArtNetSocket = nullptr;
+	FSocket *SACNSocket = nullptr;
+
+	TSet<int32> JoinedUniverses;
+
+	// Source names by sender, so a packet doesn't build one
+	TMap<uint32, FName> ArtNetSources;
+	TMap<FGuid, FName> SACNSources;
+
+	TArray<uint8> ReceivedData;
+};
@@ -14,17 +14,28 @@ class LEXYVFXCPPFIXTURES_API ULexyVFXDMXPanComponent : public ULexyVFXDMXBaseCom
 {
 	GENERATED_BODY()
 	
-protected:
-	void BeginPlay() override;
 public:
-	void UpdateDMX(TMap<FDMXAttributeName, int32> DImapDMXFunctionValues, TArray<FName> nDMXComponentFunctions) override;
+	void BindComponents() override;
+
+	FLexyVFXDMXDecodeFunction SelectDecoder(const ULexyVFXDMXFixtureType& Type) const override;
+
+	const TArray<FName>& GetFunctionNames(const ULexyVFXDMXFixtureType& Type) const override;
+
+	void ApplyOutput(const FLexyVFXDMXFixtureOutput& Output) override;
+
+	void DescribeBakedTracks(ILexyVFXDMXBakedTracks& Tracks) const override;
 
 	UPROPERTY(EditAnywhere)
 	UStaticMeshComponent *SMRef_Yoke;
 
-	UPROPERTY(EditAnywhere)
-	EDMXParameterBitDepth panBitDepth;
+#if WITH_EDITORONLY_DATA
+	bool MigrateDeprecatedConfig(ULexyVFXDMXFixtureType& Type) const override;
 
-	UPROPERTY(EditAnywhere)
-	float fPanRange = 540.0f;
+	// Moved to ULexyVFXDMXFixtureType, only loaded to migrate Blueprints saved before it
+	UPROPERTY()
+	EDMXParameterBitDepth panBitDepth_DEPRECATED = EDMXParameterBitDepth::BitDepth_8bits;
+
+	UPROPERTY()
+	float fPanRange_DEPRECATED = 540.0f;
+#endif
 };
@@ -0,0 +1,73 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "LexyVFXDMXRigBuilder.generated.h"
+
+class UDMXLibrary;
+class UDMXEntityFixtureType;
+class UDMXEntityFixturePatch;
+
+USTRUCT()
+struct FLexyVFXDMXFixtureActorPool
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<AActor*> Actors;
+};
+
+/**
+ * Spawns a fixture actor for every patch of a DMX library in one pass, laid out in a grid from the builder's transform.
+ *
+ * Cleared fixtures go back to a pool per actor class and are reused by the next build with their components, bindings
+ * and material instances intact, only their patch is swapped. Newly spawned fixtures initialize through the fixture
+ * subsystem, spread over frames when LexyVFX.DMX.MaxInitializationsPerFrame is set, and resolve their components
+ * from the names found on the first fixture of their class.
+ */
+UCLASS()
+class LEXYVFXCPPFIXTURES_API ALexyVFXDMXRigBuilder : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	ALexyVFXDMXRigBuilder();
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rig")
+	UDMXLibrary *Library;
+
+	// Fixture actor spawned for the patches of each DMX fixture type, with a DMX component and a function manager
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rig")
+	TMap<UDMXEntityFixtureType*, TSubclassOf<AActor>> FixtureClasses;
+
+	// Spawned for fixture types without an entry in FixtureClasses
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rig")
+	TSubclassOf<AActor> DefaultFixtureClass;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Layout")
+	int32 FixturesPerRow = 20;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Layout")
+	FVector2D FixtureSpacing = FVector2D(100.0f, 100.0f);
+
+	// Spawns or reuses a fixture for every patch of the library, replacing the current rig
+	UFUNCTION(CallInEditor, BlueprintCallable, Category = "Rig")
+	void BuildRig();
+
+	// Returns the rig's fixtures to the pool while playing, destroys them in the editor
+	UFUNCTION(CallInEditor, BlueprintCallable, Category = "Rig")
+	void ClearRig();
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Rig")
+	TArray<AActor*> RigFixtures;
+
+private:
+	AActor* AcquireFixture(UClass *FixtureClass, const FTransform& Transform);
+	void ReleaseFixture(AActor *Fixture);
+	void SetFixturePatch(AActor *Fixture, UDMXEntityFixturePatch *Patch);
+
+	UPROPERTY(Transient)
+	TMap<UClass*, FLexyVFXDMXFixtureActorPool> FixturePool;
+};
@@ -0,0 +1,34 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "LexyVFXDMXSequenceBaker.generated.h"
+
+class ULevelSequence;
+
+/**
+ * Bakes a recorded DMX stream (the DMX Library track of a Level Sequence, e.g. from Take Recorder) through the
+ * fixture pipeline once, and writes the resulting fixture outputs as keyframe-reduced curves into a Level Sequence.
+ * Renders of the baked sequence evaluate plain curves and never decode DMX.
+ */
+UCLASS()
+class LEXYVFXCPPFIXTURES_API ULexyVFXDMXSequenceBaker : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Fixtures are taken from the world of WorldContextObject and must have begun play (run from PIE). Each fixture
+	 * starts from the default output and is baked at full group masters, so the same sequences always bake the same.
+	 * SubSamples evaluates the DMX stream that many times per display frame, for temporal samples and motion blur.
+	 * Fixture types with bSmoothMotion move through their motor model at that sample rate.
+	 * Tolerance is the allowed error of the reduced curves, relative to each curve's value range.
+	 */
+	UFUNCTION(BlueprintCallable, meta = (WorldContext = "WorldContextObject"))
+	static bool BakeDMXToLevelSequence(UObject *WorldContextObject, ULevelSequence *DMXSequence, ULevelSequence *TargetSequence, int32 SubSamples = 1, float Tolerance = 0.001f);
+
+	// Indices of the samples to keep so that linear interpolation between them stays within Tolerance of every sample
+	static void ReduceLinearKeys(const TArray<float>& Values, float Tolerance, TArray<int32>& OutKeyIndices);
+};
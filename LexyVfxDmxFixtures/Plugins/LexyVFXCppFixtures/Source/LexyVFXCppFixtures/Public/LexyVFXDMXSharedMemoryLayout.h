@@ -0,0 +1,42 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+/*
+ * Layout of the shared-memory DMX ring, shared with external writer processes, so plain C with no engine types.
+ *
+ * A header is followed by SlotCount slots of SlotSize bytes. Frame n goes into slot n % SlotCount: the writer sets
+ * the slot's Sequence to 2n + 1 followed by a release fence, so the frame's stores can't move ahead of it, writes the
+ * frame, then sets Sequence to 2n + 2 and WriteSequence to n + 1 with release stores. A reader copies frame n out
+ * while the slot's Sequence reads 2n + 2, and keeps the copy only if Sequence still reads 2n + 2 after an acquire fence.
+ */
+
+#include <stdint.h>
+
+#define LEXYVFX_DMX_SHM_MAGIC 0x4D53584C /* "LXSM" */
+#define LEXYVFX_DMX_SHM_VERSION 1
+#define LEXYVFX_DMX_SHM_UNIVERSE_SIZE 512
+#define LEXYVFX_DMX_SHM_DEFAULT_NAME "lexyvfx_dmx"
+
+typedef struct LexyVFXDMXShmHeader
+{
+	uint32_t Magic;
+	uint32_t Version;
+	uint32_t SlotCount;
+	uint32_t SlotSize;
+
+	/* Frames written since the region was created */
+	int64_t WriteSequence;
+
+	uint8_t Reserved[40];
+} LexyVFXDMXShmHeader;
+
+typedef struct LexyVFXDMXShmSlot
+{
+	int64_t Sequence;
+	int32_t Universe;
+	uint16_t Length;
+	uint16_t Reserved;
+	uint8_t Data[LEXYVFX_DMX_SHM_UNIVERSE_SIZE];
+	uint8_t Padding[48];
+} LexyVFXDMXShmSlot;
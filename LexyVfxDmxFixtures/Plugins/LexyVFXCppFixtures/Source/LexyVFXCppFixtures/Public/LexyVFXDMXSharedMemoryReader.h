@@ -0,0 +1,44 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformMemory.h"
+
+/**
+ * Reads universe frames an external process writes into a named shared-memory ring, see LexyVFXDMXSharedMemoryLayout.h.
+ *
+ * Each frame is copied out of its slot into a scratch buffer and only handed out when the slot's sequence still reads
+ * the same after the copy, torn frames are dropped. Frames are only read while the writer is at least half a ring
+ * away from overwriting their slot, so a reader that falls behind skips frames rather than tearing them.
+ */
+class LEXYVFXCPPFIXTURES_API FLexyVFXDMXSharedMemoryReader
+{
+public:
+	~FLexyVFXDMXSharedMemoryReader();
+
+	bool Open(const FString& RegionName);
+	void Close();
+	bool IsOpen() const { return Region != nullptr; }
+
+	// Hands every frame written since the last poll to ReadFrame, oldest first. Returns the number of frames read.
+	// The view is only valid during the call.
+	int32 Poll(TFunctionRef<void(int32 Universe, TArrayView<const uint8> DMXBuffer)> ReadFrame);
+
+	const FString& GetRegionName() const { return RegionName; }
+
+	// Stats since open
+	uint64 FramesRead = 0;
+	uint64 FramesSkipped = 0;
+	uint64 FramesTorn = 0;
+
+private:
+	FPlatformMemory::FSharedMemoryRegion *Region = nullptr;
+	FString RegionName;
+	const uint8 *Slots = nullptr;
+	uint32 SlotCount = 0;
+	uint32 SlotSize = 0;
+	int64 ReadSequence = 0;
+
+	uint8 Scratch[512];
+};
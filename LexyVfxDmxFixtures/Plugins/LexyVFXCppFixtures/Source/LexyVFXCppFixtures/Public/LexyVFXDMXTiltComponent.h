@@ -14,17 +14,28 @@ class LEXYVFXCPPFIXTURES_API ULexyVFXDMXTiltComponent : public ULexyVFXDMXBaseCo
 {
 	GENERATED_BODY()
 	
-protected:
-	void BeginPlay() override;
 public:
-	void UpdateDMX(TMap<FDMXAttributeName, int32> DImapDMXFunctionValues, TArray<FName> nDMXComponentFunctions) override;
+	void BindComponents() override;
+
+	FLexyVFXDMXDecodeFunction SelectDecoder(const ULexyVFXDMXFixtureType& Type) const override;
+
+	const TArray<FName>& GetFunctionNames(const ULexyVFXDMXFixtureType& Type) const override;
+
+	void ApplyOutput(const FLexyVFXDMXFixtureOutput& Output) override;
+
+	void DescribeBakedTracks(ILexyVFXDMXBakedTracks& Tracks) const override;
 
 	UPROPERTY(EditAnywhere)
 	UStaticMeshComponent *SMRef_Head;
 
-	UPROPERTY(EditAnywhere)
-	EDMXParameterBitDepth tiltBitDepth;
+#if WITH_EDITORONLY_DATA
+	bool MigrateDeprecatedConfig(ULexyVFXDMXFixtureType& Type) const override;
 
-	UPROPERTY(EditAnywhere)
-	float fTiltRange = 250.0f;
+	// Moved to ULexyVFXDMXFixtureType, only loaded to migrate Blueprints saved before it
+	UPROPERTY()
+	EDMXParameterBitDepth tiltBitDepth_DEPRECATED = EDMXParameterBitDepth::BitDepth_8bits;
+
+	UPROPERTY()
+	float fTiltRange_DEPRECATED = 250.0f;
+#endif
 };
@@ -14,10 +14,16 @@ class LEXYVFXCPPFIXTURES_API ULexyVFXDMXZoomComponent : public ULexyVFXDMXBaseCo
 {
 	GENERATED_BODY()
 	
-protected:
-	void BeginPlay() override;
 public:
-	void UpdateDMX(TMap<FDMXAttributeName, int32> DImapDMXFunctionValues, TArray<FName> nDMXComponentFunctions) override;
+	void BindComponents() override;
+
+	FLexyVFXDMXDecodeFunction SelectDecoder(const ULexyVFXDMXFixtureType& Type) const override;
+
+	const TArray<FName>& GetFunctionNames(const ULexyVFXDMXFixtureType& Type) const override;
+
+	void ApplyOutput(const FLexyVFXDMXFixtureOutput& Output) override;
+
+	void DescribeBakedTracks(ILexyVFXDMXBakedTracks& Tracks) const override;
 
 	UPROPERTY(EditAnywhere)
 	UStaticMeshComponent *SMRef_Beam;
@@ -31,15 +37,20 @@ public:
 	UPROPERTY(EditAnywhere)
 	UMaterialInstanceDynamic *miBeam;
 
-	UPROPERTY(EditAnywhere)
-	EDMXParameterBitDepth zoomBitDepth;
+#if WITH_EDITORONLY_DATA
+	bool MigrateDeprecatedConfig(ULexyVFXDMXFixtureType& Type) const override;
 
-	UPROPERTY(EditAnywhere)
-	float fBeamRangeLinear = 4.69101f;
+	// Moved to ULexyVFXDMXFixtureType, only loaded to migrate Blueprints saved before it
+	UPROPERTY()
+	EDMXParameterBitDepth zoomBitDepth_DEPRECATED = EDMXParameterBitDepth::BitDepth_8bits;
 
-	UPROPERTY(EditAnywhere)
-	float fBeamRangeMin = 3.7f;
+	UPROPERTY()
+	float fBeamRangeLinear_DEPRECATED = 4.69101f;
 
-	UPROPERTY(EditAnywhere)
-	float fBeamRangeMax = 35.0f;
+	UPROPERTY()
+	float fBeamRangeMin_DEPRECATED = 3.7f;
+
+	UPROPERTY()
+	float fBeamRangeMax_DEPRECATED = 35.0f;
+#endif
 };
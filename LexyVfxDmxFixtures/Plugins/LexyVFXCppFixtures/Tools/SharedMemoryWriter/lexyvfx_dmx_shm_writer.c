@@ -0,0 +1,154 @@
+/*
+ * Reference writer for the LexyVFX shared-memory DMX ring, for testing the shared-memory input on Linux without a
+ * console. Writes a test pattern to a range of universes at a fixed rate, see LexyVFXDMXSharedMemoryLayout.h for
+ * the protocol a console integration has to follow.
+ *
+ * Build:
+ *   cc -O2 -I../../Source/LexyVFXCppFixtures/Public -o lexyvfx_dmx_shm_writer lexyvfx_dmx_shm_writer.c -lrt -lm
+ *
+ * Run, then set LexyVFX.DMX.SharedMemory.Name to the same name in Unreal:
+ *   ./lexyvfx_dmx_shm_writer [-n name] [-u first universe] [-c universe count] [-r rate hz] [-s slot count]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "LexyVFXDMXSharedMemoryLayout.h"
+
+#include <fcntl.h>
+#include <math.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+
+static volatile sig_atomic_t bRunning = 1;
+
+static void Stop(int Signal)
+{
+	(void)Signal;
+	bRunning = 0;
+}
+
+static void WriteFrame(LexyVFXDMXShmHeader *Header, uint8_t *Slots, int32_t Universe, const uint8_t *Data, uint16_t Length)
+{
+	const int64_t sequence = Header->WriteSequence;
+	LexyVFXDMXShmSlot *Slot = (LexyVFXDMXShmSlot*)(Slots + (size_t)(sequence % Header->SlotCount) * Header->SlotSize);
+
+	__atomic_store_n(&Slot->Sequence, 2 * sequence + 1, __ATOMIC_RELEASE);
+	/* A release store only orders what comes before it, the fence keeps the frame's stores after the odd sequence */
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+	Slot->Universe = Universe;
+	Slot->Length = Length;
+	memcpy(Slot->Data, Data, Length);
+	__atomic_store_n(&Slot->Sequence, 2 * sequence + 2, __ATOMIC_RELEASE);
+	__atomic_store_n(&Header->WriteSequence, sequence + 1, __ATOMIC_RELEASE);
+}
+
+/* A slow chase across the universe, every channel of a fixture moves so dimmer, color, pan and tilt all show it */
+static void FillPattern(uint8_t *Data, int32_t Universe, double Seconds)
+{
+	int channel;
+	for (channel = 0; channel != LEXYVFX_DMX_SHM_UNIVERSE_SIZE; channel++)
+	{
+		const double phase = Seconds * 0.5 + channel * 0.05 + Universe * 0.7;
+		Data[channel] = (uint8_t)lrint(127.5 + 127.5 * sin(phase * 6.283185307179586));
+	}
+}
+
+int main(int argc, char **argv)
+{
+	const char *Name = LEXYVFX_DMX_SHM_DEFAULT_NAME;
+	int firstUniverse = 1;
+	int universeCount = 4;
+	double rate = 44.0;
+	unsigned slotCount = 1024;
+	int option;
+
+	while ((option = getopt(argc, argv, "n:u:c:r:s:")) != -1)
+	{
+		switch (option)
+		{
+		case 'n': Name = optarg; break;
+		case 'u': firstUniverse = atoi(optarg); break;
+		case 'c': universeCount = atoi(optarg); break;
+		case 'r': rate = atof(optarg); break;
+		case 's': slotCount = (unsigned)atoi(optarg); break;
+		default:
+			fprintf(stderr, "usage: %s [-n name] [-u first universe] [-c universe count] [-r rate hz] [-s slot count]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	if (universeCount <= 0 || rate <= 0.0 || slotCount < 2)
+	{
+		fprintf(stderr, "universe count and rate must be positive, slot count at least 2\n");
+		return 1;
+	}
+
+	/* Unreal maps the region as "/" + name */
+	char ShmName[256];
+	snprintf(ShmName, sizeof(ShmName), "/%s", Name);
+
+	const size_t regionSize = sizeof(LexyVFXDMXShmHeader) + (size_t)slotCount * sizeof(LexyVFXDMXShmSlot);
+	shm_unlink(ShmName);
+	const int fd = shm_open(ShmName, O_CREAT | O_RDWR, 0644);
+	if (fd < 0 || ftruncate(fd, (off_t)regionSize) != 0)
+	{
+		perror("shm_open");
+		return 1;
+	}
+
+	uint8_t *Region = mmap(NULL, regionSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (Region == MAP_FAILED)
+	{
+		perror("mmap");
+		shm_unlink(ShmName);
+		return 1;
+	}
+
+	/* A fresh region is zeroed, the magic goes last so a reader never sees a half initialized header */
+	LexyVFXDMXShmHeader *Header = (LexyVFXDMXShmHeader*)Region;
+	uint8_t *Slots = Region + sizeof(LexyVFXDMXShmHeader);
+	Header->Version = LEXYVFX_DMX_SHM_VERSION;
+	Header->SlotCount = slotCount;
+	Header->SlotSize = sizeof(LexyVFXDMXShmSlot);
+	__atomic_store_n(&Header->Magic, LEXYVFX_DMX_SHM_MAGIC, __ATOMIC_RELEASE);
+
+	signal(SIGINT, Stop);
+	signal(SIGTERM, Stop);
+	printf("Writing universes %d-%d at %.1f Hz to %s, %u slots\n", firstUniverse, firstUniverse + universeCount - 1, rate, ShmName, slotCount);
+
+	struct timespec Start, Next;
+	clock_gettime(CLOCK_MONOTONIC, &Start);
+	Next = Start;
+	const long periodNs = (long)(1e9 / rate);
+	uint8_t Data[LEXYVFX_DMX_SHM_UNIVERSE_SIZE];
+
+	while (bRunning)
+	{
+		const double seconds = (Next.tv_sec - Start.tv_sec) + (Next.tv_nsec - Start.tv_nsec) * 1e-9;
+		int universe;
+		for (universe = firstUniverse; universe != firstUniverse + universeCount; universe++)
+		{
+			FillPattern(Data, universe, seconds);
+			WriteFrame(Header, Slots, universe, Data, LEXYVFX_DMX_SHM_UNIVERSE_SIZE);
+		}
+
+		Next.tv_nsec += periodNs;
+		while (Next.tv_nsec >= 1000000000L)
+		{
+			Next.tv_nsec -= 1000000000L;
+			Next.tv_sec++;
+		}
+		clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &Next, NULL);
+	}
+
+	printf("Wrote %lld frames\n", (long long)Header->WriteSequence);
+	munmap(Region, regionSize);
+	shm_unlink(ShmName);
+	return 0;
+}